@@ -0,0 +1,710 @@
+/**
+ * pattern_bench.c
+ *
+ * Throughput benchmark for every way this repository can print a pattern.
+ *
+ * Runs each render engine over a range of sizes and output sinks and
+ * reports the time per cell, the output bandwidth and the spread over
+ * repeated samples:
+ *
+ *   triangle    nested    nested for loops from the triangle README
+ *               single    print_triangle(), the single-loop version
+ *   concentric  edges     four-edge minimum distance from the README
+ *               diagonal  print_concentric_square(), diagonal decomposition
+ *   both        writev    library engine (lib/), one thread, writev sink
+ *               splice    library engine, vmsplice into a pipe
+ *               parallel  library engine on --threads workers
+ *
+ * Sinks are /dev/null, an unlinked temporary file, and a pipe drained by
+ * a second thread. The library engines reuse one render context across
+ * samples, as the batch programs do, so they are measured warm.
+ *
+ *   ./pattern_bench
+ *   ./pattern_bench -p concentric -n 100,1000,5000 -s pipe -r 10
+ *   ./pattern_bench --json baseline.json
+ *
+ * With --json every sample is also written to a results file, together
+ * with the CPU, compiler and flags it was measured with, for
+ * pattern_compare to check for regressions.
+ *
+ * Compile: gcc -O2 -pthread pattern_bench.c -o pattern_bench -lm
+ *          (add -DPATTERN_BENCH_CFLAGS='"-O2 -pthread"' to record the
+ *          flags in --json results)
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <math.h>
+#include <sched.h>
+#include <sys/utsname.h>
+
+// The printf renderers are benchmarked exactly as the programs ship them
+#define main triangle_main
+#include "../triangle/triangle.c"
+#undef main
+#define main concentric_main
+#include "../concentric-square/concentric_square.c"
+#undef main
+
+#define BENCH_DRAIN_BYTES (1u << 20)
+
+// Compile flags as recorded in --json results
+#ifndef PATTERN_BENCH_CFLAGS
+#define PATTERN_BENCH_CFLAGS "unrecorded"
+#endif
+
+#if defined(__clang__)
+#define BENCH_COMPILER "clang " __clang_version__
+#elif defined(__GNUC__)
+#define BENCH_COMPILER "gcc " __VERSION__
+#else
+#define BENCH_COMPILER "unknown"
+#endif
+
+/**
+ * Traditional nested-loop triangle, as shown in the triangle README
+ */
+static int nested_triangle(int n) {
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= i; j++) {
+            printf("* ");
+        }
+        printf("\n");
+        if (ferror(stdout)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Traditional concentric square: n minus the distance to the nearest of
+ * the four edges, as shown in the concentric-square README
+ */
+static int edges_concentric(int n) {
+    int m = 2 * n - 1;
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            int top_left = i < j ? i : j;
+            int bottom_right = m - 1 - i < m - 1 - j ? m - 1 - i : m - 1 - j;
+            int distance = top_left < bottom_right ? top_left : bottom_right;
+            printf("%d ", n - distance);
+        }
+        printf("\n");
+        if (ferror(stdout)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * One render engine
+ */
+typedef struct bench_engine {
+    const char *name;
+    int shape;                  // PATTERN_*, or -1 for both shapes
+    int (*reference)(int n);    // printf renderer writing to stdout
+    int sink;                   // PATTERN_SINK_* for library engines
+    int parallel;               // library engine on --threads workers
+} bench_engine;
+
+static const bench_engine bench_engines[] = {
+    {"nested",   PATTERN_TRIANGLE,   nested_triangle,         0, 0},
+    {"single",   PATTERN_TRIANGLE,   print_triangle,          0, 0},
+    {"edges",    PATTERN_CONCENTRIC, edges_concentric,        0, 0},
+    {"diagonal", PATTERN_CONCENTRIC, print_concentric_square, 0, 0},
+    {"writev",   -1, NULL, PATTERN_SINK_WRITEV, 0},
+    {"splice",   -1, NULL, PATTERN_SINK_SPLICE, 0},
+    {"parallel", -1, NULL, PATTERN_SINK_AUTO,   1},
+};
+
+#define BENCH_ENGINES (sizeof(bench_engines) / sizeof(bench_engines[0]))
+
+/**
+ * Output sink; a pipe is emptied by a drain thread so that the writer
+ * never waits on a full pipe for longer than the reader takes to copy
+ */
+typedef struct bench_sink {
+    const char *name;
+    int fd;                     // where the engines write
+    int is_pipe;
+    int drain_fd;               // read end of the pipe
+    pthread_t drain;
+    unsigned long long drained; // bytes read by the drain thread
+    unsigned long long sent;    // bytes written by the engines
+} bench_sink;
+
+static const char *const bench_sink_names[] = {"null", "file", "pipe"};
+
+#define BENCH_SINKS 3
+
+typedef struct bench_config {
+    const char *patterns;
+    const char *engines;
+    const char *sinks;
+    const char *sizes;
+    int repeats;
+    double min_ms;
+    int threads;
+    const char *json;           // results file, or NULL
+} bench_config;
+
+/**
+ * --json results file, written as the measurements come in
+ */
+typedef struct bench_json {
+    FILE *out;
+    int results;                // entries written so far
+} bench_json;
+
+/**
+ * Tests whether `name` appears in a comma-separated list
+ */
+static int bench_listed(const char *list, const char *name) {
+    size_t len = strlen(name);
+    for (const char *at = list; *at != '\0';) {
+        size_t item = strcspn(at, ",");
+        if (item == len && strncmp(at, name, len) == 0) {
+            return 1;
+        }
+        at += item + (at[item] == ',');
+    }
+    return strcmp(list, "all") == 0;
+}
+
+static void *bench_drain_main(void *arg) {
+    bench_sink *sink = arg;
+    char *buf = malloc(BENCH_DRAIN_BYTES);
+    ssize_t got;
+    while (buf != NULL &&
+           (got = read(sink->drain_fd, buf, BENCH_DRAIN_BYTES)) != 0) {
+        if (got > 0) {
+            __atomic_add_fetch(&sink->drained, (unsigned long long)got,
+                               __ATOMIC_RELEASE);
+        } else if (errno != EINTR) {
+            break;
+        }
+    }
+    free(buf);
+    return NULL;
+}
+
+static int bench_sink_open(bench_sink *sink, const char *name) {
+    memset(sink, 0, sizeof(*sink));
+    sink->name = name;
+    sink->drain_fd = -1;
+
+    if (strcmp(name, "null") == 0) {
+        sink->fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        return sink->fd < 0 ? -1 : 0;
+    }
+    if (strcmp(name, "file") == 0) {
+        const char *dir = getenv("TMPDIR");
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/pattern_bench.XXXXXX",
+                 dir != NULL ? dir : "/tmp");
+        sink->fd = mkostemp(path, O_CLOEXEC);
+        if (sink->fd >= 0) {
+            unlink(path);
+        }
+        return sink->fd < 0 ? -1 : 0;
+    }
+
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        return -1;
+    }
+    // Same pipe size for every engine, not only the splice one
+    fcntl(fds[1], F_SETPIPE_SZ, PATTERN_PIPE_SIZE);
+    sink->fd = fds[1];
+    sink->drain_fd = fds[0];
+    sink->is_pipe = 1;
+    if (pthread_create(&sink->drain, NULL, bench_drain_main, sink) != 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Rewinds a file sink before a sample, so files do not grow across
+ * samples
+ */
+static void bench_sink_rewind(bench_sink *sink) {
+    if (!sink->is_pipe && strcmp(sink->name, "file") == 0 &&
+        ftruncate(sink->fd, 0) == 0) {
+        lseek(sink->fd, 0, SEEK_SET);
+    }
+}
+
+/**
+ * Waits until the drain thread has read everything written to a pipe
+ * sink; a sample is not over while its output sits in the pipe
+ */
+static void bench_sink_wait(bench_sink *sink) {
+    while (sink->is_pipe &&
+           __atomic_load_n(&sink->drained, __ATOMIC_ACQUIRE) < sink->sent) {
+        sched_yield();
+    }
+}
+
+static void bench_sink_close(bench_sink *sink) {
+    close(sink->fd);
+    if (sink->is_pipe) {
+        pthread_join(sink->drain, NULL);
+        close(sink->drain_fd);
+    }
+}
+
+/**
+ * A running engine: either stdout pointed at the sink, or a warm
+ * render context writing to it
+ */
+typedef struct bench_target {
+    const bench_engine *engine;
+    bench_sink *sink;
+    pattern_ctx ctx;
+    int shape;
+} bench_target;
+
+static int bench_target_open(bench_target *t, const bench_engine *engine,
+                             bench_sink *sink, int shape, int threads) {
+    t->engine = engine;
+    t->sink = sink;
+    t->shape = shape;
+    if (engine->reference != NULL) {
+        fflush(stdout);
+        return dup2(sink->fd, STDOUT_FILENO) < 0 ? -1 : 0;
+    }
+    return pattern_ctx_init(&t->ctx, sink->fd, engine->sink,
+                            engine->parallel ? threads : 1);
+}
+
+/**
+ * Renders one pattern all the way into the sink
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static int bench_target_render(bench_target *t, size_t n) {
+    t->sink->sent += pattern_total_bytes(t->shape, n);
+    if (t->engine->reference != NULL) {
+        int status = t->engine->reference((int)n);
+        return status != 0 || fflush(stdout) != 0 ? -1 : 0;
+    }
+    if (pattern_render(&t->ctx, t->shape, n) != 0) {
+        return -1;
+    }
+    return pattern_ctx_flush(&t->ctx);
+}
+
+static void bench_target_close(bench_target *t) {
+    if (t->engine->reference == NULL) {
+        pattern_ctx_close(&t->ctx);
+        return;
+    }
+    // Let go of the sink, so that a pipe's drain thread sees end of file
+    int null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null >= 0) {
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+}
+
+/**
+ * Summary of the samples of one (shape, engine, sink, n) cell
+ */
+typedef struct bench_result {
+    double mean_ns;             // per render
+    double stdev_ns;
+    double best_ns;
+    unsigned long long iters;   // renders per sample
+    double *samples_ns;         // per render, one per sample
+} bench_result;
+
+/**
+ * Times `repeats` samples of `iters` renders each, where `iters` is
+ * chosen so that one sample lasts at least `min_ms`
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static int bench_measure(bench_target *t, size_t n, const bench_config *cfg,
+                         bench_result *res) {
+    // Warm-up render, which also sizes the samples
+    bench_sink_rewind(t->sink);
+    unsigned long long start = pattern_now_ns();
+    if (bench_target_render(t, n) != 0) {
+        return -1;
+    }
+    bench_sink_wait(t->sink);
+    double once = (double)(pattern_now_ns() - start);
+    double want = cfg->min_ms * 1e6;
+    res->iters = once >= want ? 1 : (unsigned long long)(want / once) + 1;
+
+    double sum = 0, sum_sq = 0;
+    res->best_ns = INFINITY;
+    for (int r = 0; r < cfg->repeats; r++) {
+        bench_sink_rewind(t->sink);
+        start = pattern_now_ns();
+        for (unsigned long long i = 0; i < res->iters; i++) {
+            if (bench_target_render(t, n) != 0) {
+                return -1;
+            }
+        }
+        bench_sink_wait(t->sink);
+        double per = (double)(pattern_now_ns() - start) / (double)res->iters;
+        res->samples_ns[r] = per;
+        sum += per;
+        sum_sq += per * per;
+        if (per < res->best_ns) {
+            res->best_ns = per;
+        }
+    }
+
+    res->mean_ns = sum / cfg->repeats;
+    double var = cfg->repeats > 1
+                     ? (sum_sq - sum * sum / cfg->repeats) /
+                           (cfg->repeats - 1)
+                     : 0;
+    res->stdev_ns = var > 0 ? sqrt(var) : 0;
+    return 0;
+}
+
+/**
+ * Writes a JSON string literal
+ */
+static void bench_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * CPU model from /proc/cpuinfo ("model name", or "Model" on ARM)
+ */
+static void bench_cpu_model(char *buf, size_t size) {
+    snprintf(buf, size, "unknown");
+    FILE *info = fopen("/proc/cpuinfo", "r");
+    char line[512];
+    while (info != NULL && fgets(line, sizeof(line), info) != NULL) {
+        char *colon = strchr(line, ':');
+        if (colon != NULL && (strncmp(line, "model name", 10) == 0 ||
+                              strncmp(line, "Model", 5) == 0)) {
+            colon += 1 + strspn(colon + 1, " \t");
+            colon[strcspn(colon, "\n")] = '\0';
+            snprintf(buf, size, "%s", colon);
+            break;
+        }
+    }
+    if (info != NULL) {
+        fclose(info);
+    }
+}
+
+/**
+ * Starts a results file: where and how the numbers were measured
+ *
+ * @return 0 on success, -1 if the file could not be created
+ */
+static int bench_json_open(bench_json *json, const bench_config *cfg,
+                           const size_t *sizes, int count) {
+    json->results = 0;
+    json->out = fopen(cfg->json, "w");
+    if (json->out == NULL) {
+        return -1;
+    }
+
+    char cpu[256], date[32];
+    struct utsname host;
+    time_t now = time(NULL);
+    bench_cpu_model(cpu, sizeof(cpu));
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    if (uname(&host) != 0) {
+        snprintf(host.release, sizeof(host.release), "unknown");
+    }
+
+    size_t n_min = sizes[0], n_max = sizes[0];
+    for (int i = 1; i < count; i++) {
+        n_min = sizes[i] < n_min ? sizes[i] : n_min;
+        n_max = sizes[i] > n_max ? sizes[i] : n_max;
+    }
+
+    FILE *out = json->out;
+    fprintf(out, "{\n  \"format\": \"pattern_bench/1\",\n");
+    fprintf(out, "  \"date\": \"%s\",\n", date);
+    fprintf(out, "  \"host\": {\"cpu\": ");
+    bench_json_string(out, cpu);
+    fprintf(out, ", \"cpus\": %ld, \"kernel\": ",
+            sysconf(_SC_NPROCESSORS_ONLN));
+    bench_json_string(out, host.release);
+    fprintf(out, "},\n  \"build\": {\"compiler\": ");
+    bench_json_string(out, BENCH_COMPILER);
+    fprintf(out, ", \"flags\": ");
+    bench_json_string(out, PATTERN_BENCH_CFLAGS);
+    fprintf(out, "},\n  \"config\": {\"sizes\": [");
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%s%zu", i ? ", " : "", sizes[i]);
+    }
+    fprintf(out, "], \"n_min\": %zu, \"n_max\": %zu, \"repeats\": %d, "
+                 "\"min_ms\": %g, \"threads\": %d},\n",
+            n_min, n_max, cfg->repeats, cfg->min_ms, cfg->threads);
+    fprintf(out, "  \"results\": [");
+    return 0;
+}
+
+static void bench_json_result(bench_json *json, const bench_config *cfg,
+                              int shape, const char *engine,
+                              const char *sink, size_t n,
+                              const bench_result *res) {
+    FILE *out = json->out;
+    unsigned long long cells = pattern_cells(shape, n);
+    unsigned long long bytes = pattern_total_bytes(shape, n);
+
+    fprintf(out, "%s\n    {\"pattern\": \"%s\", \"engine\": \"%s\", "
+                 "\"sink\": \"%s\", \"n\": %zu, \"cells\": %llu, "
+                 "\"bytes\": %llu, \"iters\": %llu,\n",
+            json->results++ ? "," : "", pattern_shape_names[shape], engine,
+            sink, n, cells, bytes, res->iters);
+    fprintf(out, "     \"mean_ns\": %.1f, \"stdev_ns\": %.1f, "
+                 "\"best_ns\": %.1f, \"ns_per_cell\": %.4f, "
+                 "\"mb_per_s\": %.2f,\n     \"samples_ns\": [",
+            res->mean_ns, res->stdev_ns, res->best_ns,
+            res->mean_ns / (double)cells, (double)bytes / res->mean_ns * 1e3);
+    for (int r = 0; r < cfg->repeats; r++) {
+        fprintf(out, "%s%.1f", r ? ", " : "", res->samples_ns[r]);
+    }
+    fprintf(out, "]}");
+}
+
+/**
+ * Finishes the results file
+ *
+ * @return 0 on success, -1 if it could not be written completely
+ */
+static int bench_json_close(bench_json *json) {
+    fprintf(json->out, "\n  ]\n}\n");
+    int failed = ferror(json->out);
+    return fclose(json->out) != 0 || failed ? -1 : 0;
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_bench [options]\n"
+        "\n"
+        "  -p, --pattern LIST  triangle,concentric (default: all)\n"
+        "  -e, --engines LIST  nested,single,edges,diagonal,writev,splice,"
+        "parallel\n"
+        "                      (default: all)\n"
+        "  -s, --sinks LIST    null,file,pipe (default: all)\n"
+        "  -n, --sizes LIST    sizes to render (default: 10,100,1000)\n"
+        "  -r, --repeats N     samples per measurement (default: 5)\n"
+        "  -m, --min-ms MS     shortest sample; small sizes are repeated\n"
+        "                      until a sample lasts this long (default: 20)\n"
+        "  -j, --threads N     workers for the parallel engine\n"
+        "                      (default: online CPUs)\n"
+        "  -J, --json FILE     also write every sample to FILE as JSON\n"
+        "  -h, --help          show this help\n");
+}
+
+/**
+ * Runs one shape at one size over every selected sink and engine
+ *
+ * The first engine of the shape (the nested-loop reference) is the
+ * baseline for the speedup column.
+ */
+static void bench_size(FILE *report, bench_json *json,
+                       const bench_config *cfg, int shape, size_t n) {
+    unsigned long long cells = pattern_cells(shape, n);
+    unsigned long long bytes = pattern_total_bytes(shape, n);
+
+    for (int s = 0; s < BENCH_SINKS; s++) {
+        if (!bench_listed(cfg->sinks, bench_sink_names[s])) {
+            continue;
+        }
+        bench_sink sink;
+        if (bench_sink_open(&sink, bench_sink_names[s]) != 0) {
+            fprintf(stderr, "pattern_bench: %s sink: %s\n",
+                    bench_sink_names[s], strerror(errno));
+            continue;
+        }
+
+        double baseline = 0;
+        for (size_t e = 0; e < BENCH_ENGINES; e++) {
+            const bench_engine *engine = &bench_engines[e];
+            if ((engine->shape >= 0 && engine->shape != shape) ||
+                !bench_listed(cfg->engines, engine->name) ||
+                (engine->sink == PATTERN_SINK_SPLICE && !sink.is_pipe)) {
+                continue;
+            }
+
+            bench_target target;
+            double samples[cfg->repeats];
+            bench_result res = {.samples_ns = samples};
+            if (bench_target_open(&target, engine, &sink, shape,
+                                  cfg->threads) != 0) {
+                fprintf(stderr, "pattern_bench: %s: cannot start\n",
+                        engine->name);
+                continue;
+            }
+            int failed = bench_measure(&target, n, cfg, &res);
+            bench_target_close(&target);
+            if (failed) {
+                fprintf(stderr, "pattern_bench: %s/%s: write failed\n",
+                        engine->name, sink.name);
+                continue;
+            }
+
+            if (baseline == 0) {
+                baseline = res.mean_ns;
+            }
+            fprintf(report,
+                    "%-10s %-8s %-4s %9zu %13llu %9.3f %10.1f %6.1f "
+                    "%9.3f %8.2fx\n",
+                    pattern_shape_names[shape], engine->name, sink.name, n,
+                    cells, res.mean_ns / (double)cells,
+                    (double)bytes / res.mean_ns * 1e3,
+                    res.stdev_ns / res.mean_ns * 100,
+                    res.best_ns / (double)cells, baseline / res.mean_ns);
+            fflush(report);
+            if (json->out != NULL) {
+                bench_json_result(json, cfg, shape, engine->name, sink.name,
+                                  n, &res);
+            }
+        }
+        bench_sink_close(&sink);
+    }
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"pattern", required_argument, NULL, 'p'},
+        {"engines", required_argument, NULL, 'e'},
+        {"sinks",   required_argument, NULL, 's'},
+        {"sizes",   required_argument, NULL, 'n'},
+        {"repeats", required_argument, NULL, 'r'},
+        {"min-ms",  required_argument, NULL, 'm'},
+        {"threads", required_argument, NULL, 'j'},
+        {"json",    required_argument, NULL, 'J'},
+        {"help",    no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    bench_config cfg = {
+        .patterns = "all",
+        .engines = "all",
+        .sinks = "all",
+        .sizes = "10,100,1000",
+        .repeats = 5,
+        .min_ms = 20,
+        .threads = (int)sysconf(_SC_NPROCESSORS_ONLN),
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "p:e:s:n:r:m:j:J:h", longopts,
+                              NULL)) != -1) {
+        switch (opt) {
+        case 'p':
+            cfg.patterns = optarg;
+            break;
+        case 'e':
+            cfg.engines = optarg;
+            break;
+        case 's':
+            cfg.sinks = optarg;
+            break;
+        case 'n':
+            cfg.sizes = optarg;
+            break;
+        case 'r':
+            cfg.repeats = atoi(optarg);
+            break;
+        case 'm':
+            cfg.min_ms = atof(optarg);
+            break;
+        case 'j':
+            cfg.threads = atoi(optarg);
+            break;
+        case 'J':
+            cfg.json = optarg;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (optind != argc || cfg.repeats < 1 || cfg.min_ms < 0 ||
+        cfg.threads < 1 || cfg.threads > PATTERN_MAX_THREADS) {
+        usage(stderr);
+        return 1;
+    }
+    pattern_ignore_sigpipe();
+
+    // Sizes up front, so that a results file can record the range
+    size_t sizes[64];
+    int size_count = 0;
+    for (const char *at = cfg.sizes; *at != '\0';) {
+        size_t item = strcspn(at, ",");
+        char text[32];
+        snprintf(text, sizeof(text), "%.*s", (int)item, at);
+        at += item + (at[item] == ',');
+        if (size_count == 64 ||
+            pattern_parse_size(text, &sizes[size_count++]) != 0) {
+            fprintf(stderr, "pattern_bench: bad size '%s'\n", text);
+            return 1;
+        }
+    }
+    if (size_count == 0) {
+        usage(stderr);
+        return 1;
+    }
+
+    bench_json json = {.out = NULL};
+    if (cfg.json != NULL &&
+        bench_json_open(&json, &cfg, sizes, size_count) != 0) {
+        fprintf(stderr, "pattern_bench: %s: %s\n", cfg.json,
+                strerror(errno));
+        return 1;
+    }
+
+    // stdout is taken over by the printf engines; results go to a copy
+    FILE *report = fdopen(dup(STDOUT_FILENO), "w");
+    if (report == NULL) {
+        fprintf(stderr, "pattern_bench: %s\n", strerror(errno));
+        return 1;
+    }
+    fprintf(report,
+            "%-10s %-8s %-4s %9s %13s %9s %10s %6s %9s %9s\n",
+            "pattern", "engine", "sink", "n", "cells", "ns/cell", "MB/s",
+            "+-%", "best", "speedup");
+
+    for (int shape = 0; shape < PATTERN_SHAPES; shape++) {
+        if (!bench_listed(cfg.patterns, pattern_shape_names[shape])) {
+            continue;
+        }
+        for (int i = 0; i < size_count; i++) {
+            bench_size(report, &json, &cfg, shape, sizes[i]);
+        }
+    }
+    fclose(report);
+
+    if (json.out != NULL && bench_json_close(&json) != 0) {
+        fprintf(stderr, "pattern_bench: %s: write failed\n", cfg.json);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,263 @@
+/**
+ * pattern_cells.c
+ *
+ * Cell-kernel benchmark for the concentric square.
+ *
+ * Compares the per-cell formula of print_concentric_square() (region
+ * picked with `if (i + j < m)`, maxima with the MAX macro) against the
+ * branchless concentric_cell() from lib/pattern_concentric.h. Values are
+ * generated without printf, so only the kernel is timed, in two access
+ * orders:
+ *
+ *   sequential  row by row over the whole (2n-1)×(2n-1) square; the
+ *               region boundary moves one column per row
+ *   random      cells at random coordinates, so the region of the next
+ *               cell cannot be predicted at all
+ *
+ * Time per cell is always reported. Cycles per cell and branch misses
+ * per cell come from the same perf counters as --stats
+ * (lib/pattern_stats.h), where the machine provides them.
+ *
+ *   ./pattern_cells
+ *   ./pattern_cells -n 5000 -r 10
+ *
+ * Compile: gcc -O2 pattern_cells.c -o pattern_cells -lm
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "../lib/pattern_stats.h"
+
+// Macro to compute maximum of two values, as in concentric_square.c
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/**
+ * The cell formula of print_concentric_square(), unchanged
+ */
+static inline uint32_t branchy_cell(int n, int i, int j) {
+    int m = 2 * n - 1;
+    if (i + j < m) {
+        return (uint32_t)MAX(n - i, n - j);
+    }
+    return (uint32_t)(MAX(i - n, j - n) + 2);
+}
+
+// One call per row or per batch, so both kernels pay the same call cost
+// and the compiler cannot specialize across the timing loop
+
+static __attribute__((noinline)) uint64_t row_branchy(int n, int i) {
+    uint64_t sum = 0;
+    for (int j = 0; j < 2 * n - 1; j++) {
+        sum += branchy_cell(n, i, j);
+    }
+    return sum;
+}
+
+static __attribute__((noinline)) uint64_t row_branchless(int n, int i) {
+    uint64_t sum = 0;
+    for (int j = 0; j < 2 * n - 1; j++) {
+        sum += concentric_cell(n, i, j);
+    }
+    return sum;
+}
+
+static __attribute__((noinline)) uint64_t random_branchy(
+        int n, const uint32_t *ci, const uint32_t *cj, size_t count) {
+    uint64_t sum = 0;
+    for (size_t k = 0; k < count; k++) {
+        sum += branchy_cell(n, (int)ci[k], (int)cj[k]);
+    }
+    return sum;
+}
+
+static __attribute__((noinline)) uint64_t random_branchless(
+        int n, const uint32_t *ci, const uint32_t *cj, size_t count) {
+    uint64_t sum = 0;
+    for (size_t k = 0; k < count; k++) {
+        sum += concentric_cell(n, ci[k], cj[k]);
+    }
+    return sum;
+}
+
+typedef struct cells_run {
+    int n;
+    const uint32_t *ci;         // random coordinates
+    const uint32_t *cj;
+    size_t count;
+} cells_run;
+
+/**
+ * Runs one kernel in one access order
+ *
+ * @return Checksum of the generated values
+ */
+static uint64_t cells_pass(const cells_run *run, int branchless,
+                           int random) {
+    uint64_t sum = 0;
+    if (random) {
+        sum = branchless
+                  ? random_branchless(run->n, run->ci, run->cj, run->count)
+                  : random_branchy(run->n, run->ci, run->cj, run->count);
+    } else {
+        for (int i = 0; i < 2 * run->n - 1; i++) {
+            sum += branchless ? row_branchless(run->n, i)
+                              : row_branchy(run->n, i);
+        }
+    }
+    return sum;
+}
+
+/**
+ * Checks the branchless kernel against the reference formula on every
+ * cell of a few sizes
+ */
+static int cells_verify(void) {
+    static const int sizes[] = {1, 2, 3, 4, 7, 10, 99, 100, 101, 257};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        for (int i = 0; i < 2 * n - 1; i++) {
+            for (int j = 0; j < 2 * n - 1; j++) {
+                if (concentric_cell(n, i, j) != branchy_cell(n, i, j)) {
+                    fprintf(stderr,
+                            "pattern_cells: mismatch at n=%d (%d, %d)\n", n,
+                            i, j);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_cells [options]\n"
+        "\n"
+        "  -n, --size N        square to scan sequentially (default: 2000)\n"
+        "  -c, --cells N       random cells per pass (default: 4194304)\n"
+        "  -r, --repeats N     passes per measurement (default: 5)\n"
+        "  -h, --help          show this help\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"size",    required_argument, NULL, 'n'},
+        {"cells",   required_argument, NULL, 'c'},
+        {"repeats", required_argument, NULL, 'r'},
+        {"help",    no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    cells_run run = {.n = 2000, .count = 1u << 22};
+    int repeats = 5;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:c:r:h", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            run.n = atoi(optarg);
+            break;
+        case 'c':
+            run.count = (size_t)strtoull(optarg, NULL, 10);
+            break;
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (optind != argc || run.n < 1 || run.n > 1000000 || run.count < 1 ||
+        repeats < 1) {
+        usage(stderr);
+        return 1;
+    }
+    if (cells_verify() != 0) {
+        return 1;
+    }
+
+    // Random coordinates inside the square (xorshift64)
+    uint32_t *ci = malloc(run.count * sizeof(*ci));
+    uint32_t *cj = malloc(run.count * sizeof(*cj));
+    if (ci == NULL || cj == NULL) {
+        fprintf(stderr, "pattern_cells: out of memory\n");
+        return 1;
+    }
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    uint32_t side = (uint32_t)(2 * run.n - 1);
+    for (size_t k = 0; k < run.count; k++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        ci[k] = (uint32_t)(seed % side);
+        cj[k] = (uint32_t)((seed >> 32) % side);
+    }
+    run.ci = ci;
+    run.cj = cj;
+
+    pattern_stats st;
+    pattern_stats_open(&st);
+    if (st.error != 0) {
+        printf("counters unavailable (%s); reporting time only\n\n",
+               strerror(st.error));
+    }
+
+    printf("%-10s %-10s %12s %9s %6s %11s %13s\n", "kernel", "access",
+           "cells", "ns/cell", "+-%", "cells/cycle", "br-miss/cell");
+    for (int random = 0; random <= 1; random++) {
+        double cells = random ? (double)run.count : (double)side * side;
+        uint64_t expect = 0;
+        for (int branchless = 0; branchless <= 1; branchless++) {
+            double sum = 0, sum_sq = 0;
+            unsigned long long cycles = 0, misses = 0;
+            uint64_t check = cells_pass(&run, branchless, random);
+
+            for (int r = 0; r < repeats; r++) {
+                pattern_stats_begin(&st, NULL);
+                check = cells_pass(&run, branchless, random);
+                pattern_stats_end(&st, NULL);
+                double per = (double)st.wall_ns / cells;
+                sum += per;
+                sum_sq += per * per;
+                cycles += st.count[PATTERN_STATS_CYCLES];
+                misses += st.count[PATTERN_STATS_BRANCH_MISS];
+            }
+            if (branchless && check != expect) {
+                fprintf(stderr, "pattern_cells: checksum mismatch\n");
+                return 1;
+            }
+            expect = check;
+
+            double mean = sum / repeats;
+            double var = repeats > 1
+                             ? (sum_sq - sum * sum / repeats) / (repeats - 1)
+                             : 0;
+            printf("%-10s %-10s %12.0f %9.3f %6.1f",
+                   branchless ? "branchless" : "branchy",
+                   random ? "random" : "sequential", cells, mean,
+                   var > 0 ? sqrt(var) / mean * 100 : 0.0);
+            if (st.error == 0 && cycles > 0) {
+                printf(" %11.3f %13.4f\n", cells * repeats / (double)cycles,
+                       (double)misses / (cells * repeats));
+            } else {
+                printf(" %11s %13s\n", "n/a", "n/a");
+            }
+        }
+    }
+
+    pattern_stats_close(&st);
+    free(ci);
+    free(cj);
+    return 0;
+}
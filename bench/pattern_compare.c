@@ -0,0 +1,525 @@
+/**
+ * pattern_compare.c
+ *
+ * Regression gate for pattern_bench results.
+ *
+ * Compares two files written by `pattern_bench --json` measurement by
+ * measurement (pattern, engine, sink, n). A measurement regresses when
+ * its throughput dropped by more than the threshold AND a one-sided
+ * Welch t-test over the samples says the slowdown is unlikely to be
+ * noise (p below --alpha). Both conditions are needed: a large drop on
+ * a noisy machine is not trusted, and a significant 0.5% drop is not
+ * worth failing a release over.
+ *
+ *   ./pattern_bench --json base.json          # on the release
+ *   ./pattern_bench --json head.json          # on the candidate
+ *   ./pattern_compare --threshold 3 base.json head.json
+ *
+ * Exit status: 0 if nothing regressed, 2 if something did, 1 if the
+ * files could not be read.
+ *
+ * Compile: gcc -O2 pattern_compare.c -o pattern_compare -lm
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <ctype.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPARE_EXIT_REGRESSED 2
+
+/**
+ * Parsed JSON value
+ *
+ * Just enough JSON for pattern_bench output: objects keep their keys in
+ * order, numbers are doubles.
+ */
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT,
+} json_type;
+
+typedef struct json_value {
+    json_type type;
+    double number;
+    char *string;
+    struct json_value *items;   // array elements or object values
+    char **keys;                // object keys
+    size_t count;
+} json_value;
+
+typedef struct json_parser {
+    const char *at;
+    const char *error;
+} json_parser;
+
+static void json_skip(json_parser *p) {
+    while (isspace((unsigned char)*p->at)) {
+        p->at++;
+    }
+}
+
+static int json_parse(json_parser *p, json_value *v);
+
+static char *json_parse_string(json_parser *p) {
+    // Escapes only shorten the text, so the input length is enough
+    const char *end = p->at + 1;
+    while (*end != '\0' && *end != '"') {
+        end += end[0] == '\\' && end[1] != '\0' ? 2 : 1;
+    }
+    char *out = malloc((size_t)(end - p->at));
+    char *w = out;
+    for (p->at++; out != NULL && p->at < end; p->at++) {
+        if (*p->at != '\\') {
+            *w++ = *p->at;
+            continue;
+        }
+        switch (*++p->at) {
+        case 'n':
+            *w++ = '\n';
+            break;
+        case 't':
+            *w++ = '\t';
+            break;
+        case 'u': {
+            // pattern_bench only escapes control characters this way;
+            // anything beyond ASCII is kept as '?'
+            char hex[5] = {0};
+            long code = 0;
+            if (end - p->at > 4) {
+                memcpy(hex, p->at + 1, 4);
+                code = strtol(hex, NULL, 16);
+                p->at += 4;
+            }
+            *w++ = code > 0 && code < 0x80 ? (char)code : '?';
+            break;
+        }
+        default:
+            *w++ = *p->at;
+        }
+    }
+    if (out == NULL || *end != '"') {
+        p->error = out == NULL ? "out of memory" : "unterminated string";
+        free(out);
+        return NULL;
+    }
+    *w = '\0';
+    p->at = end + 1;
+    return out;
+}
+
+/**
+ * Parses the elements of an array or the members of an object, after
+ * the opening bracket
+ */
+static int json_parse_list(json_parser *p, json_value *v, char close) {
+    size_t cap = 0;
+    json_skip(p);
+    if (*p->at == close) {
+        p->at++;
+        return 0;
+    }
+    for (;;) {
+        if (v->count == cap) {
+            cap = cap ? cap * 2 : 8;
+            v->items = realloc(v->items, cap * sizeof(*v->items));
+            if (close == '}') {
+                v->keys = realloc(v->keys, cap * sizeof(*v->keys));
+            }
+            if (v->items == NULL || (close == '}' && v->keys == NULL)) {
+                p->error = "out of memory";
+                return -1;
+            }
+        }
+
+        json_skip(p);
+        if (close == '}') {
+            if (*p->at != '"' ||
+                (v->keys[v->count] = json_parse_string(p)) == NULL) {
+                p->error = p->error ? p->error : "expected a key";
+                return -1;
+            }
+            json_skip(p);
+            if (*p->at++ != ':') {
+                p->error = "expected ':'";
+                return -1;
+            }
+        }
+        if (json_parse(p, &v->items[v->count]) != 0) {
+            return -1;
+        }
+        v->count++;
+
+        json_skip(p);
+        if (*p->at == ',') {
+            p->at++;
+        } else if (*p->at == close) {
+            p->at++;
+            return 0;
+        } else {
+            p->error = "expected ',' or a closing bracket";
+            return -1;
+        }
+    }
+}
+
+static int json_parse(json_parser *p, json_value *v) {
+    memset(v, 0, sizeof(*v));
+    json_skip(p);
+    switch (*p->at) {
+    case '{':
+        v->type = JSON_OBJECT;
+        p->at++;
+        return json_parse_list(p, v, '}');
+    case '[':
+        v->type = JSON_ARRAY;
+        p->at++;
+        return json_parse_list(p, v, ']');
+    case '"':
+        v->type = JSON_STRING;
+        v->string = json_parse_string(p);
+        return v->string == NULL ? -1 : 0;
+    }
+    if (strncmp(p->at, "true", 4) == 0 || strncmp(p->at, "null", 4) == 0) {
+        v->type = *p->at == 't' ? JSON_BOOL : JSON_NULL;
+        v->number = *p->at == 't';
+        p->at += 4;
+        return 0;
+    }
+    if (strncmp(p->at, "false", 5) == 0) {
+        v->type = JSON_BOOL;
+        p->at += 5;
+        return 0;
+    }
+    char *end;
+    v->type = JSON_NUMBER;
+    v->number = strtod(p->at, &end);
+    if (end == p->at) {
+        p->error = "unexpected character";
+        return -1;
+    }
+    p->at = end;
+    return 0;
+}
+
+static void json_free(json_value *v) {
+    for (size_t i = 0; i < v->count; i++) {
+        json_free(&v->items[i]);
+        if (v->keys != NULL) {
+            free(v->keys[i]);
+        }
+    }
+    free(v->items);
+    free(v->keys);
+    free(v->string);
+}
+
+/**
+ * Member of an object, or NULL
+ */
+static const json_value *json_get(const json_value *v, const char *key) {
+    for (size_t i = 0; v->type == JSON_OBJECT && i < v->count; i++) {
+        if (strcmp(v->keys[i], key) == 0) {
+            return &v->items[i];
+        }
+    }
+    return NULL;
+}
+
+static const char *json_text(const json_value *v, const char *key) {
+    const json_value *m = json_get(v, key);
+    return m != NULL && m->type == JSON_STRING ? m->string : "?";
+}
+
+static double json_number(const json_value *v, const char *key) {
+    const json_value *m = json_get(v, key);
+    return m != NULL && m->type == JSON_NUMBER ? m->number : NAN;
+}
+
+/**
+ * Reads and parses a results file
+ *
+ * @return 0 on success, -1 after printing why it failed
+ */
+static int load_results(const char *path, json_value *root) {
+    FILE *in = fopen(path, "r");
+    char *text = NULL;
+    size_t len = 0;
+    if (in != NULL) {
+        FILE *buf = open_memstream(&text, &len);
+        char chunk[65536];
+        size_t got;
+        while (buf != NULL && (got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+            fwrite(chunk, 1, got, buf);
+        }
+        if (buf != NULL) {
+            fclose(buf);
+        }
+        fclose(in);
+    }
+    if (text == NULL) {
+        fprintf(stderr, "pattern_compare: %s: cannot read\n", path);
+        return -1;
+    }
+
+    json_parser p = {.at = text};
+    int status = json_parse(&p, root);
+    if (status == 0 && (json_get(root, "results") == NULL ||
+                        json_get(root, "results")->type != JSON_ARRAY)) {
+        p.error = "no \"results\" array (not pattern_bench --json output?)";
+        status = -1;
+    }
+    if (status != 0) {
+        fprintf(stderr, "pattern_compare: %s: %s at byte %td\n", path,
+                p.error, p.at - text);
+    }
+    free(text);
+    return status;
+}
+
+/**
+ * Regularized incomplete beta function I_x(a, b), by Lentz's continued
+ * fraction
+ */
+static double incomplete_beta(double x, double a, double b) {
+    if (x <= 0) {
+        return 0;
+    }
+    if (x >= 1) {
+        return 1;
+    }
+    // The fraction converges quickly only below the mean; use symmetry
+    if (x > (a + 1) / (a + b + 2)) {
+        return 1 - incomplete_beta(1 - x, b, a);
+    }
+
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) +
+                       a * log(x) + b * log(1 - x)) / a;
+    double f = 1, c = 1, d = 0;
+    for (int i = 0; i <= 400; i++) {
+        int m = i / 2;
+        double num;
+        if (i == 0) {
+            num = 1;
+        } else if (i % 2 == 0) {
+            num = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        } else {
+            num = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        }
+        d = 1 + num * d;
+        d = fabs(d) < 1e-300 ? 1e-300 : d;
+        d = 1 / d;
+        c = 1 + num / c;
+        c = fabs(c) < 1e-300 ? 1e-300 : c;
+        f *= c * d;
+        if (fabs(1 - c * d) < 1e-12) {
+            break;
+        }
+    }
+    return front * (f - 1);
+}
+
+/**
+ * Sample mean and variance of a "samples_ns" array, falling back to the
+ * summary fields for results without samples
+ */
+typedef struct sample_stats {
+    double mean;
+    double var;
+    double count;
+} sample_stats;
+
+static sample_stats result_stats(const json_value *r) {
+    sample_stats s = {
+        .mean = json_number(r, "mean_ns"),
+        .var = pow(json_number(r, "stdev_ns"), 2),
+        .count = 1,
+    };
+    const json_value *samples = json_get(r, "samples_ns");
+    if (samples == NULL || samples->type != JSON_ARRAY ||
+        samples->count == 0) {
+        return s;
+    }
+
+    double sum = 0, sum_sq = 0;
+    for (size_t i = 0; i < samples->count; i++) {
+        sum += samples->items[i].number;
+        sum_sq += samples->items[i].number * samples->items[i].number;
+    }
+    s.count = (double)samples->count;
+    s.mean = sum / s.count;
+    s.var = s.count > 1 ? (sum_sq - sum * sum / s.count) / (s.count - 1) : 0;
+    s.var = s.var > 0 ? s.var : 0;
+    return s;
+}
+
+/**
+ * One-sided Welch t-test: probability of seeing the new samples this
+ * much slower than the old ones if the true means were equal
+ */
+static double slower_p_value(sample_stats old, sample_stats now) {
+    double se2 = old.var / old.count + now.var / now.count;
+    if (old.count < 2 || now.count < 2) {
+        return 1;               // not enough samples to tell
+    }
+    if (se2 == 0) {
+        return now.mean > old.mean ? 0 : 1;
+    }
+    double t = (now.mean - old.mean) / sqrt(se2);
+    double df = se2 * se2 /
+                (pow(old.var / old.count, 2) / (old.count - 1) +
+                 pow(now.var / now.count, 2) / (now.count - 1));
+    double tail = 0.5 * incomplete_beta(df / (df + t * t), df / 2, 0.5);
+    return t > 0 ? tail : 1 - tail;
+}
+
+static int same_measurement(const json_value *a, const json_value *b) {
+    return strcmp(json_text(a, "pattern"), json_text(b, "pattern")) == 0 &&
+           strcmp(json_text(a, "engine"), json_text(b, "engine")) == 0 &&
+           strcmp(json_text(a, "sink"), json_text(b, "sink")) == 0 &&
+           json_number(a, "n") == json_number(b, "n");
+}
+
+/**
+ * Prints where a results file was measured, and warns about differences
+ * that make the comparison meaningless
+ */
+static void compare_headers(const json_value *old, const json_value *now) {
+    static const char *const fields[][2] = {
+        {"host", "cpu"},
+        {"build", "compiler"},
+        {"build", "flags"},
+    };
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        const json_value *a = json_get(old, fields[f][0]);
+        const json_value *b = json_get(now, fields[f][0]);
+        const char *x = a ? json_text(a, fields[f][1]) : "?";
+        const char *y = b ? json_text(b, fields[f][1]) : "?";
+        if (strcmp(x, y) == 0) {
+            printf("%-9s %s\n", fields[f][1], x);
+        } else {
+            printf("%-9s %s -> %s%s\n", fields[f][1], x, y,
+                   f == 0 ? "  (warning: different CPUs)" : "");
+        }
+    }
+    printf("\n");
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_compare [options] old.json new.json\n"
+        "\n"
+        "  -t, --threshold PCT  throughput drop that counts as a regression\n"
+        "                       (default: 5)\n"
+        "  -a, --alpha P        significance level of the t-test "
+        "(default: 0.01)\n"
+        "  -h, --help           show this help\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"threshold", required_argument, NULL, 't'},
+        {"alpha",     required_argument, NULL, 'a'},
+        {"help",      no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    double threshold = 5;
+    double alpha = 0.01;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "t:a:h", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 't':
+            threshold = atof(optarg);
+            break;
+        case 'a':
+            alpha = atof(optarg);
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (optind + 2 != argc || threshold < 0 || threshold >= 100 ||
+        alpha <= 0 || alpha >= 1) {
+        usage(stderr);
+        return 1;
+    }
+
+    json_value old, now;
+    if (load_results(argv[optind], &old) != 0 ||
+        load_results(argv[optind + 1], &now) != 0) {
+        return 1;
+    }
+    compare_headers(&old, &now);
+
+    const json_value *old_results = json_get(&old, "results");
+    const json_value *new_results = json_get(&now, "results");
+    int regressions = 0, compared = 0;
+
+    printf("%-10s %-8s %-4s %9s %10s %10s %8s %9s  %s\n", "pattern",
+           "engine", "sink", "n", "old MB/s", "new MB/s", "change", "p",
+           "verdict");
+    for (size_t i = 0; i < new_results->count; i++) {
+        const json_value *b = &new_results->items[i];
+        const json_value *a = NULL;
+        for (size_t j = 0; j < old_results->count && a == NULL; j++) {
+            if (same_measurement(&old_results->items[j], b)) {
+                a = &old_results->items[j];
+            }
+        }
+        if (a == NULL) {
+            continue;
+        }
+
+        sample_stats sa = result_stats(a), sb = result_stats(b);
+        double bytes = json_number(b, "bytes");
+        // Throughput change; negative means the new build is slower
+        double change = (sa.mean / sb.mean - 1) * 100;
+        double p_slower = slower_p_value(sa, sb);
+        double p_faster = slower_p_value(sb, sa);
+        const char *verdict = "same";
+        double p = fmin(p_slower, p_faster);
+        if (change < -threshold && p_slower < alpha) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (change > threshold && p_faster < alpha) {
+            verdict = "faster";
+        } else if (fabs(change) > threshold) {
+            verdict = "noise";
+        }
+
+        printf("%-10s %-8s %-4s %9.0f %10.1f %10.1f %+7.1f%% %9.2g  %s\n",
+               json_text(b, "pattern"), json_text(b, "engine"),
+               json_text(b, "sink"), json_number(b, "n"),
+               bytes / sa.mean * 1e3, bytes / sb.mean * 1e3, change, p,
+               verdict);
+        compared++;
+    }
+
+    printf("\n%d measurements compared, %d regressed by more than %g%% "
+           "(p < %g)\n",
+           compared, regressions, threshold, alpha);
+    json_free(&old);
+    json_free(&now);
+    if (compared == 0) {
+        fprintf(stderr, "pattern_compare: no measurements in common\n");
+        return 1;
+    }
+    return regressions ? COMPARE_EXIT_REGRESSED : 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * pattern_stream.c
+ *
+ * Normal versus non-temporal stores for renders into memory.
+ *
+ * Renders a pattern into an anonymous buffer with pattern_render_buffer()
+ * twice per size, once with normal stores and once with streaming stores
+ * (PATTERN_STREAM_OFF / PATTERN_STREAM_ON), and measures:
+ *
+ *   GB/s       render throughput into the (already faulted) buffer
+ *   probe      ns per cache line of a pointer chase over a working set
+ *              that was warm before the render: how much of the rest of
+ *              the process's data the render pushed out of the cache
+ *   corun      the same chase run by a second thread while the renders
+ *              are in progress (needs more than one CPU)
+ *
+ * The probe and corun columns are what a co-running workload pays; with
+ * streaming stores they should stay close to the baseline of a probe
+ * right after warming. An "idle" row per size repeats the probe after
+ * spinning for as long as one render took, as a control.
+ *
+ *   ./pattern_stream
+ *   ./pattern_stream -n 2000,6000 -w 16384
+ *
+ * Compile: gcc -O2 -pthread pattern_stream.c -o pattern_stream -lm
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "../lib/pattern_render.h"
+
+#define STREAM_LINE 64
+
+/**
+ * Working set walked as one random cycle of cache lines, so every step
+ * is a dependent load the prefetchers cannot guess
+ */
+typedef struct stream_ring {
+    size_t *next;           // next[line * 8] = following line
+    size_t lines;
+} stream_ring;
+
+static int ring_init(stream_ring *ring, size_t bytes) {
+    ring->lines = bytes / STREAM_LINE;
+    ring->next = pattern_map(ring->lines * STREAM_LINE);
+    if (ring->next == NULL || ring->lines < 2) {
+        return -1;
+    }
+    // Sattolo's shuffle gives a single cycle through every line
+    size_t *order = malloc(ring->lines * sizeof(*order));
+    if (order == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < ring->lines; i++) {
+        order[i] = i;
+    }
+    unsigned long long seed = 0x9e3779b97f4a7c15ULL;
+    for (size_t i = ring->lines - 1; i > 0; i--) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        size_t j = (size_t)(seed % i);
+        size_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (size_t i = 0; i < ring->lines; i++) {
+        ring->next[order[i] * (STREAM_LINE / sizeof(size_t))] =
+            order[(i + 1) % ring->lines];
+    }
+    free(order);
+    return 0;
+}
+
+/**
+ * Walks `steps` lines of the ring
+ *
+ * @return Where the walk ended, so the loads cannot be optimized away
+ */
+static size_t ring_walk(const stream_ring *ring, size_t at, size_t steps) {
+    for (size_t s = 0; s < steps; s++) {
+        at = ring->next[at * (STREAM_LINE / sizeof(size_t))];
+    }
+    return at;
+}
+
+static unsigned long long thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * Second thread chasing the ring for as long as `phase` is not 0,
+ * charging its CPU time and steps to the current phase
+ */
+typedef struct stream_corun {
+    const stream_ring *ring;
+    int phase;                      // 0 = stop, 1 = idle, 1 + stores mode
+    unsigned long long ns[4];
+    unsigned long long steps[4];
+    size_t sink;
+} stream_corun;
+
+static void *corun_main(void *arg) {
+    stream_corun *c = arg;
+    size_t at = 0;
+    int phase;
+    while ((phase = __atomic_load_n(&c->phase, __ATOMIC_ACQUIRE)) != 0) {
+        unsigned long long start = thread_cpu_ns();
+        at = ring_walk(c->ring, at, 4096);
+        c->ns[phase] += thread_cpu_ns() - start;
+        c->steps[phase] += 4096;
+    }
+    c->sink = at;
+    return NULL;
+}
+
+/**
+ * ns per line of one full pass over a ring that was warm before `work`
+ */
+static double probe_after(const stream_ring *ring, void (*work)(void *),
+                          void *arg) {
+    ring_walk(ring, 0, ring->lines);        // warm
+    if (work != NULL) {
+        work(arg);
+    }
+    unsigned long long start = pattern_now_ns();
+    size_t end = ring_walk(ring, 0, ring->lines);
+    double ns = (double)(pattern_now_ns() - start);
+    return ns / (double)ring->lines + (double)(end == (size_t)-1);
+}
+
+typedef struct stream_job {
+    pattern_ctx *ctx;
+    int shape;
+    size_t n;
+    char *dst;
+} stream_job;
+
+static void stream_render(void *arg) {
+    stream_job *job = arg;
+    pattern_render_buffer(job->ctx, job->shape, job->n, job->dst);
+}
+
+/**
+ * Control for the probe: spins, touching no memory, for as long as a
+ * render took. If the probe is slow after this too, something else on
+ * the machine (other tenants of a VM, interrupts) is evicting the
+ * working set and the probe column cannot be trusted.
+ */
+static void idle_wait(void *arg) {
+    unsigned long long start = pattern_now_ns();
+    while (pattern_now_ns() - start < *(unsigned long long *)arg) {
+    }
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_stream [options]\n"
+        "\n"
+        "  -p, --pattern NAME  triangle | concentric (default: concentric)\n"
+        "  -n, --sizes LIST    sizes to render (default: 1000,3000,6000)\n"
+        "  -w, --working KB    working set of the probe (default: a quarter\n"
+        "                      of the last-level cache, at most 16384)\n"
+        "  -r, --repeats N     renders per measurement (default: 5)\n"
+        "  -h, --help          show this help\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"pattern", required_argument, NULL, 'p'},
+        {"sizes",   required_argument, NULL, 'n'},
+        {"working", required_argument, NULL, 'w'},
+        {"repeats", required_argument, NULL, 'r'},
+        {"help",    no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int shape = PATTERN_CONCENTRIC;
+    const char *sizes = "1000,3000,6000";
+    size_t working = pattern_llc_bytes() / 4;
+    int repeats = 5;
+    working = working < (16u << 20) ? working : (16u << 20);
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "p:n:w:r:h", longopts, NULL)) !=
+           -1) {
+        switch (opt) {
+        case 'p':
+            shape = pattern_shape_parse(optarg);
+            break;
+        case 'n':
+            sizes = optarg;
+            break;
+        case 'w':
+            working = (size_t)strtoull(optarg, NULL, 10) << 10;
+            break;
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (optind != argc || shape < 0 || repeats < 1 ||
+        working < 2 * STREAM_LINE) {
+        usage(stderr);
+        return 1;
+    }
+
+    stream_ring ring;
+    if (ring_init(&ring, working) != 0) {
+        fprintf(stderr, "pattern_stream: out of memory\n");
+        return 1;
+    }
+    pattern_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    // The co-runner only means something with a CPU of its own
+    int corun = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+    stream_corun co = {.ring = &ring, .phase = 1};
+    pthread_t thread;
+    if (corun && pthread_create(&thread, NULL, corun_main, &co) != 0) {
+        corun = 0;
+    }
+
+    printf("kernels %s, last-level cache %zu KB, probe working set %zu KB\n",
+           pattern_isa_names[pattern_isa()], pattern_llc_bytes() >> 10,
+           working >> 10);
+    printf("probe with nothing in between: %.2f ns/line\n\n",
+           probe_after(&ring, NULL, NULL));
+    printf("%-10s %6s %12s %-9s %8s %6s %12s %12s\n", "pattern", "n",
+           "bytes", "stores", "GB/s", "+-%", "probe ns", "corun ns");
+
+    for (const char *s = sizes; *s != '\0';) {
+        char *end;
+        size_t n = (size_t)strtoull(s, &end, 10);
+        s = *end == ',' ? end + 1 : end;
+        if (n == 0 || (*end != ',' && *end != '\0')) {
+            usage(stderr);
+            return 1;
+        }
+        size_t bytes = (size_t)pattern_total_bytes(shape, n);
+        stream_job job = {&ctx, shape, n, pattern_map(bytes)};
+        if (job.dst == NULL || pattern_ctx_reserve(&ctx, shape, n) != 0) {
+            fprintf(stderr, "pattern_stream: n=%zu: out of memory\n", n);
+            return 1;
+        }
+        ctx.stream = PATTERN_STREAM_OFF;
+        stream_render(&job);                // fault the buffer in
+
+        unsigned long long render_ns = 0;
+        for (int mode = 1; mode <= 2; mode++) {
+            ctx.stream = mode == 1 ? PATTERN_STREAM_OFF : PATTERN_STREAM_ON;
+            double sum = 0, sum_sq = 0;
+            unsigned long long corun_ns = co.ns[1 + mode];
+            unsigned long long corun_steps = co.steps[1 + mode];
+            __atomic_store_n(&co.phase, 1 + mode, __ATOMIC_RELEASE);
+            for (int r = 0; r < repeats; r++) {
+                unsigned long long start = pattern_now_ns();
+                stream_render(&job);
+                double gbs = (double)bytes /
+                             (double)(pattern_now_ns() - start);
+                sum += gbs;
+                sum_sq += gbs * gbs;
+                render_ns = mode == 1 ? pattern_now_ns() - start : render_ns;
+            }
+            __atomic_store_n(&co.phase, 1, __ATOMIC_RELEASE);
+            double probe = probe_after(&ring, stream_render, &job);
+
+            double mean = sum / repeats;
+            double var = repeats > 1
+                             ? (sum_sq - sum * sum / repeats) / (repeats - 1)
+                             : 0;
+            printf("%-10s %6zu %12zu %-9s %8.2f %6.1f %12.2f",
+                   pattern_shape_names[shape], n, bytes,
+                   mode == 1 ? "normal" : "streaming", mean,
+                   var > 0 ? sqrt(var) / mean * 100 : 0.0, probe);
+            if (corun && co.steps[1 + mode] > corun_steps) {
+                printf(" %12.2f\n", (double)(co.ns[1 + mode] - corun_ns) /
+                                        (double)(co.steps[1 + mode] -
+                                                 corun_steps));
+            } else {
+                printf(" %12s\n", "n/a");
+            }
+        }
+        printf("%-10s %6zu %12s %-9s %8s %6s %12.2f %12s\n",
+               pattern_shape_names[shape], n, "-", "idle", "-", "-",
+               probe_after(&ring, idle_wait, &render_ns), "-");
+        pattern_unmap(job.dst, bytes);
+    }
+
+    if (corun) {
+        __atomic_store_n(&co.phase, 0, __ATOMIC_RELEASE);
+        pthread_join(thread, NULL);
+        printf("\ncorun between renders: %.2f ns/line\n",
+               co.steps[1] ? (double)co.ns[1] / (double)co.steps[1] : 0.0);
+    } else {
+        printf("\ncorun: n/a, one CPU online\n");
+    }
+    return 0;
+}
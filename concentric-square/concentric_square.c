@@ -7,16 +7,29 @@
  * This implementation divides the grid along the anti-diagonal (i+j=m-1)
  * into two triangular regions, each using a different distance formula.
  * 
- * Compile: gcc concentric_square.c -o concentric_square
- * Run: ./concentric_square
+ * The program itself is a batch tool: it renders one square per size
+ * given as an argument or per line of stdin, with no prompt or banner.
+ * Apart from --sink stdio, which uses print_concentric_square() below,
+ * rows are assembled from two shared number ladders
+ * (lib/pattern_concentric.h). If the consumer goes away early
+ * (./concentric_square 5000 | head), output stops within one chunk and
+ * the program exits with status 3.
+ * 
+ * Compile: gcc -O2 -pthread concentric_square.c -o concentric_square
+ * Run: ./concentric_square 4        or        seq 1 10 | ./concentric_square
  * 
  * Author: Dev Lunagariya
  * Date: January 2026
  * License: MIT
  */
 
+#define _GNU_SOURCE
+
+#include <errno.h>
 #include <stdio.h>
 
+#include "../lib/pattern_cli.h"
+
 // Macro to compute maximum of two values
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
@@ -48,15 +61,17 @@
  *   All satisfy i + j = 6 (which is m-1 for m=7)
  * 
  * @param n Size parameter (creates (2n-1)×(2n-1) grid)
+ * @return 0 on success, -1 if stdout failed (e.g. the reader of a pipe
+ *         went away); the loops stop at the next row boundary
  * 
  * Time Complexity: O(n²) - nested loops through (2n-1)² cells
  * Space Complexity: O(1) - only constant extra variables
  */
-void print_concentric_square(int n) {
+int print_concentric_square(int n) {
     // Validate input
     if (n <= 0) {
         printf("Error: n must be a positive integer\n");
-        return;
+        return 0;
     }
     
     // Calculate grid dimensions
@@ -122,70 +137,33 @@ void print_concentric_square(int n) {
         
         // Move to next row after completing current row
         printf("\n");
-    }
-}
-
-/**
- * Helper function to visualize which region each cell belongs to
- * Useful for understanding the diagonal decomposition
- */
-void visualize_regions(int n) {
-    int m = 2 * n - 1;
-    
-    printf("Region visualization (U = Upper-left, L = Lower-right):\n");
-    
-    for (int i = 0; i < m; i++) {
-        for (int j = 0; j < m; j++) {
-            // Check which side of the diagonal we're on
-            if (i + j < m) {
-                printf("U ");
-            } else {
-                printf("L ");
-            }
+        
+        // A failed flush of the stdio buffer means nobody is reading:
+        // stop instead of formatting the remaining rows
+        if (ferror(stdout)) {
+            return -1;
         }
-        printf("\n");
     }
-    printf("\n");
+    return 0;
 }
 
 /**
- * Main function - demonstrates the concentric square pattern
+ * Main function - batch command line
+ * 
+ * Sizes come from the arguments, or one per line from stdin; see
+ * lib/pattern_cli.h (or ./concentric_square --help) for the options.
+ * Requests are served from one render context, so the number ladders are
+ * formatted once for the largest square in the batch.
  */
-int main() {
-    int size;
+int main(int argc, char **argv) {
+    pattern_cli cli = {
+        .program = "concentric_square",
+        .shape = PATTERN_CONCENTRIC,
+        .threads = 1,
+    };
     
-    printf("Concentric Square Pattern - Diagonal Decomposition\n");
-    printf("==================================================\n\n");
+    // The printf implementation above backs --sink stdio
+    cli.reference[PATTERN_CONCENTRIC] = print_concentric_square;
     
-    // Get input from user
-    printf("Enter the size parameter n: ");
-    if (scanf("%d", &size) != 1) {
-        printf("Invalid input. Please enter a positive integer.\n");
-        return 1;
-    }
-    
-    printf("\n");
-    
-    // Show region decomposition for educational purposes
-    if (size <= 7) {  // Only show for smaller sizes to avoid clutter
-        visualize_regions(size);
-    }
-    
-    // Print the concentric square
-    printf("Concentric square pattern:\n");
-    print_concentric_square(size);
-    
-    printf("\n");
-    
-    // Show additional examples
-    printf("\nExamples of other sizes:\n");
-    printf("------------------------\n\n");
-    
-    printf("n = 3:\n");
-    print_concentric_square(3);
-    
-    printf("\nn = 5:\n");
-    print_concentric_square(5);
-    
-    return 0;
+    return pattern_cli_main(&cli, argc, argv);
 }
@@ -0,0 +1,147 @@
+/**
+ * pattern_client.c
+ *
+ * Command line client for pattern_daemon.
+ *
+ * Fetches one pattern from the daemon, maps the returned memfd read-only
+ * and writes it to stdout. With --repeat it fetches the same pattern over
+ * and over on one connection and reports the round-trip latency, which is
+ * what a consumer sees once the daemon has the render cached:
+ *
+ *   ./pattern_client concentric 4
+ *   ./pattern_client --repeat 10000 --quiet concentric 5000
+ *
+ * Compile: gcc -O2 -pthread pattern_client.c -o pattern_client
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../lib/pattern_ipc.h"
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long *)a;
+    unsigned long long y = *(const unsigned long long *)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_client [options] <triangle|concentric> n\n"
+        "\n"
+        "  -s, --socket PATH   daemon socket (default: %s)\n"
+        "  -r, --repeat N      fetch N times and report latency\n"
+        "  -q, --quiet         do not write the pattern to stdout\n"
+        "  -h, --help          show this help\n",
+        PATTERN_IPC_SOCKET);
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"socket", required_argument, NULL, 's'},
+        {"repeat", required_argument, NULL, 'r'},
+        {"quiet",  no_argument,       NULL, 'q'},
+        {"help",   no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = PATTERN_IPC_SOCKET;
+    long repeat = 1;
+    int quiet = 0;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:r:qh", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 's':
+            path = optarg;
+            break;
+        case 'r':
+            repeat = atol(optarg);
+            break;
+        case 'q':
+            quiet = 1;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+
+    size_t n;
+    int shape = optind + 2 == argc ? pattern_shape_parse(argv[optind]) : -1;
+    if (shape < 0 || pattern_parse_size(argv[optind + 1], &n) != 0 ||
+        repeat < 1) {
+        usage(stderr);
+        return 1;
+    }
+
+    int sock = pattern_ipc_connect(path);
+    if (sock < 0) {
+        fprintf(stderr, "pattern_client: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    unsigned long long *latency = malloc((size_t)repeat * sizeof(*latency));
+    const char *data = NULL;
+    size_t size = 0;
+    for (long r = 0; r < repeat && latency != NULL; r++) {
+        unsigned long long start = now_ns();
+        if (data != NULL) {
+            munmap((void *)data, size);
+        }
+        int err = pattern_ipc_fetch(sock, shape, n, 0, &data, &size);
+        if (err != 0) {
+            fprintf(stderr, "pattern_client: %s\n", strerror(err));
+            return 1;
+        }
+        latency[r] = now_ns() - start;
+    }
+    close(sock);
+
+    if (repeat > 1) {
+        // The first fetch may include the render; the rest are cache hits
+        unsigned long long first = latency[0];
+        qsort(latency + 1, (size_t)repeat - 1, sizeof(*latency),
+              compare_u64);
+        fprintf(stderr,
+                "%ld fetches of %zu bytes: first %.1f us, median %.1f us, "
+                "p99 %.1f us\n",
+                repeat, size, (double)first / 1000.0,
+                (double)latency[1 + (repeat - 1) / 2] / 1000.0,
+                (double)latency[1 + (size_t)((double)(repeat - 1) * 0.99)] /
+                    1000.0);
+    }
+    free(latency);
+
+    // Straight from the daemon's pages to stdout
+    if (!quiet) {
+        pattern_ignore_sigpipe();
+        for (size_t at = 0; at < size;) {
+            ssize_t put = write(STDOUT_FILENO, data + at, size - at);
+            if (put < 0 && errno == EINTR) {
+                continue;
+            }
+            if (put <= 0) {
+                return pattern_output_status(errno);
+            }
+            at += (size_t)put;
+        }
+    }
+    return 0;
+}
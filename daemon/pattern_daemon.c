@@ -0,0 +1,370 @@
+/**
+ * pattern_daemon.c
+ *
+ * Render daemon for co-located consumers.
+ *
+ * Accepts render requests on a Unix domain socket and answers each one
+ * with a sealed memfd holding the rendered pattern, passed over
+ * SCM_RIGHTS (protocol in lib/pattern_ipc.h). Clients map it read-only,
+ * so a repeated large render costs one socket round trip and an mmap,
+ * not a re-render and not a copy.
+ *
+ * Results are cached by (shape, n, options) and shared by every client.
+ * When several clients ask for the same uncached pattern at once, one of
+ * them renders it and the others wait for that render instead of
+ * starting their own. Patterns over --entry-max bytes are refused with
+ * EFBIG before anything is allocated, since a single render of the
+ * largest valid n would not fit in memory. The cache is bounded by
+ * --cache; evicting an entry
+ * only closes the daemon's descriptor, and clients that still map it
+ * keep a valid copy until they unmap it.
+ *
+ * Compile: gcc -O2 -pthread pattern_daemon.c -o pattern_daemon
+ * Run: ./pattern_daemon --socket /tmp/pattern_daemon.sock
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <stdio.h>
+
+#include "../lib/pattern_ipc.h"
+
+/**
+ * One cached render
+ *
+ * While `ready` is 0 another thread is rendering it; waiters sleep on
+ * the cache's condition variable. A failed render stays in the list
+ * with its errno until the last waiter has seen it.
+ */
+typedef struct daemon_entry {
+    int shape;
+    size_t n;
+    uint32_t options;
+    int fd;                     // sealed memfd once ready
+    size_t size;
+    int ready;
+    int status;                 // errno of a failed render
+    int waiters;
+    unsigned long long used;    // LRU clock value of the last hit
+    struct daemon_entry *next;
+} daemon_entry;
+
+typedef struct daemon_cache {
+    pthread_mutex_t lock;
+    pthread_cond_t rendered;
+    daemon_entry *head;
+    size_t bytes;
+    size_t budget;
+    size_t entry_max;           // larger renders are refused (EFBIG)
+    unsigned long long clock;
+} daemon_cache;
+
+typedef struct daemon_client {
+    int sock;
+    daemon_cache *cache;
+} daemon_client;
+
+/**
+ * Renders a pattern into a new memfd and seals it read-only
+ *
+ * The writable mapping is dropped before sealing: F_SEAL_WRITE is
+ * refused while a shared writable mapping exists.
+ *
+ * @return Sealed memfd, or -1 with errno set
+ */
+static int render_sealed(pattern_ctx *ctx, int shape, size_t n,
+                         size_t size) {
+    if (pattern_ctx_reserve(ctx, shape, n) != 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    int fd = memfd_create("pattern", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return -1;
+    }
+    char *data = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (data == MAP_FAILED) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+
+    pattern_render_buffer(ctx, shape, n, data);
+    munmap(data, size);
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW |
+                               F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    return fd;
+}
+
+static void entry_unlink(daemon_cache *cache, daemon_entry *entry) {
+    for (daemon_entry **link = &cache->head; *link != NULL;
+         link = &(*link)->next) {
+        if (*link == entry) {
+            *link = entry->next;
+            return;
+        }
+    }
+}
+
+/**
+ * Drops least recently used entries until the cache fits its budget
+ * (called with the lock held)
+ *
+ * Entries with waiters are skipped: a waiter woken by the broadcast may
+ * not have the lock back yet, and still reads the entry once it does.
+ * The cache can stay over budget until they are gone.
+ */
+static void cache_trim(daemon_cache *cache, const daemon_entry *keep) {
+    while (cache->bytes > cache->budget) {
+        daemon_entry *victim = NULL;
+        for (daemon_entry *e = cache->head; e != NULL; e = e->next) {
+            if (e != keep && e->ready && e->status == 0 &&
+                e->waiters == 0 &&
+                (victim == NULL || e->used < victim->used)) {
+                victim = e;
+            }
+        }
+        if (victim == NULL) {
+            return;
+        }
+        entry_unlink(cache, victim);
+        cache->bytes -= victim->size;
+        close(victim->fd);
+        free(victim);
+    }
+}
+
+/**
+ * Returns a duplicate of the memfd for (shape, n, options), rendering it
+ * first if no other client has
+ *
+ * The duplicate keeps the memory alive while the reply is being sent,
+ * even if the entry is evicted meanwhile.
+ *
+ * @return Descriptor to send (caller closes it), or -1 with errno set
+ */
+static int cache_acquire(daemon_cache *cache, pattern_ctx *ctx, int shape,
+                         size_t n, uint32_t options, size_t *size) {
+    pthread_mutex_lock(&cache->lock);
+
+    daemon_entry *entry = cache->head;
+    while (entry != NULL && (entry->shape != shape || entry->n != n ||
+                             entry->options != options)) {
+        entry = entry->next;
+    }
+
+    // A failed render nobody is waiting on is retried
+    if (entry != NULL && entry->ready && entry->status != 0 &&
+        entry->waiters == 0) {
+        entry_unlink(cache, entry);
+        free(entry);
+        entry = NULL;
+    }
+
+    if (entry == NULL) {
+        // Miss: claim the render, then do it without holding the lock
+        entry = calloc(1, sizeof(*entry));
+        if (entry == NULL) {
+            pthread_mutex_unlock(&cache->lock);
+            errno = ENOMEM;
+            return -1;
+        }
+        entry->shape = shape;
+        entry->n = n;
+        entry->options = options;
+        entry->fd = -1;
+        entry->size = (size_t)pattern_total_bytes(shape, n);
+        entry->next = cache->head;
+        cache->head = entry;
+        pthread_mutex_unlock(&cache->lock);
+
+        int fd = render_sealed(ctx, shape, n, entry->size);
+        int err = errno;
+
+        pthread_mutex_lock(&cache->lock);
+        entry->fd = fd;
+        entry->status = fd < 0 ? err : 0;
+        entry->ready = 1;
+        if (fd >= 0) {
+            cache->bytes += entry->size;
+            cache_trim(cache, entry);
+        }
+        pthread_cond_broadcast(&cache->rendered);
+    } else {
+        // Hit, or a render in progress on another connection
+        entry->waiters++;
+        while (!entry->ready) {
+            pthread_cond_wait(&cache->rendered, &cache->lock);
+        }
+        entry->waiters--;
+    }
+
+    int fd = -1;
+    int err = entry->status;
+    if (err == 0) {
+        entry->used = ++cache->clock;
+        *size = entry->size;
+        fd = fcntl(entry->fd, F_DUPFD_CLOEXEC, 0);
+        err = fd < 0 ? errno : 0;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    errno = err;
+    return fd;
+}
+
+static void *client_main(void *arg) {
+    daemon_client client = *(daemon_client *)arg;
+    free(arg);
+
+    // Each connection renders with its own masters
+    pattern_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    pattern_ipc_request request;
+    while (pattern_ipc_recv_all(client.sock, &request,
+                                sizeof(request)) == 0) {
+        pattern_ipc_reply reply = {.magic = PATTERN_IPC_MAGIC};
+        size_t n = (size_t)request.n;
+        int fd = -1;
+
+        if (request.magic != PATTERN_IPC_MAGIC) {
+            break;
+        }
+        if (request.shape >= PATTERN_SHAPES || request.n == 0 ||
+            request.n > PATTERN_MAX_N || request.options != 0) {
+            reply.status = EINVAL;
+        } else if (pattern_total_bytes((int)request.shape, n) >
+                   client.cache->entry_max) {
+            reply.status = EFBIG;
+        } else {
+            size_t size = 0;
+            fd = cache_acquire(client.cache, &ctx, (int)request.shape, n,
+                               request.options, &size);
+            reply.status = fd < 0 ? errno : 0;
+            reply.size = size;
+        }
+
+        int sent = pattern_ipc_send_reply(client.sock, &reply, fd);
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (sent != 0) {
+            break;
+        }
+    }
+
+    close(client.sock);
+    triangle_master_free(&ctx.tri);
+    concentric_master_free(&ctx.con);
+    return NULL;
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_daemon [options]\n"
+        "\n"
+        "  -s, --socket PATH   socket to listen on (default: %s)\n"
+        "  -c, --cache MB      render cache budget (default: 1024)\n"
+        "  -e, --entry-max MB  largest pattern rendered (default: 256)\n"
+        "  -h, --help          show this help\n",
+        PATTERN_IPC_SOCKET);
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"socket",    required_argument, NULL, 's'},
+        {"cache",     required_argument, NULL, 'c'},
+        {"entry-max", required_argument, NULL, 'e'},
+        {"help",      no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = PATTERN_IPC_SOCKET;
+    daemon_cache cache = {
+        .budget = (size_t)1024 << 20,
+        .entry_max = (size_t)256 << 20,
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:c:e:h", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 's':
+            path = optarg;
+            break;
+        case 'c':
+            cache.budget = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 'e':
+            cache.entry_max = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+
+    // An entry larger than the whole cache could never be kept
+    if (cache.entry_max > cache.budget) {
+        cache.entry_max = cache.budget;
+    }
+
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "pattern_daemon: socket path too long\n");
+        return 1;
+    }
+    strcpy(addr.sun_path, path);
+
+    pattern_ignore_sigpipe();
+    pthread_mutex_init(&cache.lock, NULL);
+    pthread_cond_init(&cache.rendered, NULL);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(path);
+    if (listener < 0 ||
+        bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(listener, 128) != 0) {
+        fprintf(stderr, "pattern_daemon: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+    fprintf(stderr, "pattern_daemon: listening on %s\n", path);
+
+    for (;;) {
+        int sock = accept4(listener, NULL, NULL, SOCK_CLOEXEC);
+        if (sock < 0) {
+            continue;
+        }
+        daemon_client *client = malloc(sizeof(*client));
+        pthread_t thread;
+        if (client == NULL) {
+            close(sock);
+            continue;
+        }
+        client->sock = sock;
+        client->cache = &cache;
+        if (pthread_create(&thread, NULL, client_main, client) != 0) {
+            close(sock);
+            free(client);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+}
@@ -0,0 +1,642 @@
+/**
+ * pattern_cli.h
+ *
+ * Batch command line shared by the pattern programs.
+ *
+ * Sizes come from the arguments, or one request per line from stdin when
+ * there are none, so a single process can serve thousands of renders:
+ *
+ *   ./triangle 3 5 8
+ *   seq 1 1000 | ./concentric_square --format framed
+ *   printf 'triangle 4\nconcentric 3\n' | ./triangle
+ *   printf 'pyramid 4\ninverted 3\n' | ./triangle
+ *   ./triangle --format rle 100000 | ./triangle --decode
+ *
+ * There is no banner and no prompt; stdout carries nothing but patterns
+ * (and, with --format framed, one header line per pattern). Every
+ * request is rendered through one warmed pattern_ctx.
+ *
+ * Exit status: 0 on success, 1 if the usage was wrong or any request
+ * was rejected, PATTERN_EXIT_CLOSED if the consumer closed the pipe.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_CLI_H
+#define PATTERN_CLI_H
+
+#include <getopt.h>
+#include <stdio.h>
+
+#include "pattern_aggregate.h"
+#include "pattern_compact.h"
+#include "pattern_image.h"
+#include "pattern_matrix.h"
+#include "pattern_rle.h"
+#include "pattern_stats.h"
+#include "pattern_tune.h"
+
+// Extra sinks that only exist at the CLI level: the program's own
+// printf renderer (print_triangle / print_concentric_square), and whole
+// patterns rendered into memory (pattern_render_memory / _file)
+#define PATTERN_SINK_STDIO  3
+#define PATTERN_SINK_BUFFER 4
+#define PATTERN_SINK_MMAP   5
+
+// Output formats
+#define PATTERN_FORMAT_TEXT   0     // patterns back to back
+#define PATTERN_FORMAT_FRAMED 1     // "<shape> <n> <bytes>\n" + pattern
+#define PATTERN_FORMAT_RLE    2     // one run-length message per pattern
+#define PATTERN_FORMAT_RAW    3     // concentric value matrices, binary
+#define PATTERN_FORMAT_NPY    4     // the same, each with a .npy header
+#define PATTERN_FORMAT_PGM    5     // concentric squares as gray images
+#define PATTERN_FORMAT_PPM    6     // the same, palette-mapped to color
+
+/**
+ * Parsed options plus the program's reference renderers
+ */
+typedef struct pattern_cli {
+    const char *program;
+    int shape;                  // default pattern for bare sizes
+    int variant;                // TRIANGLE_* for triangle requests
+    const char *output;         // NULL or "-" for stdout
+    int sink;
+    int threads;
+    int format;
+    int quiet;
+    int stats;                  // report counters and timing per render
+    int self_test;              // check the kernel variants and exit
+    int decode;                 // expand rle messages from stdin
+    int pages;                  // PATTERN_PAGES_*, buffer and mmap sinks
+    int prefault;               // populate those before rendering
+    int pin;                    // bind workers to CPUs, node by node
+    int autotune;               // measure the engines, save the profile
+    const char *profile_path;   // --profile, else the default location
+    pattern_profile profile;    // engine thresholds for --sink auto
+    int mappable;               // auto sink on a file open O_RDWR
+    int rejected;               // requests that could not be served
+    // printf-based renderers available for --sink stdio, by shape
+    int (*reference[PATTERN_SHAPES])(int n);
+    pattern_stats perf;         // used with --stats
+} pattern_cli;
+
+static inline void pattern_cli_usage(const pattern_cli *cli, FILE *to) {
+    fprintf(to,
+        "usage: %s [options] [n ...]\n"
+        "\n"
+        "Renders one pattern per size. Without sizes, reads requests from\n"
+        "stdin, one per line: \"n\" or \"<pattern> n\", where a triangle\n"
+        "variant name is a pattern too.\n"
+        "\n"
+        "  -p, --pattern NAME  triangle | concentric (default: %s)\n"
+        "  -t, --variant NAME  left | right | inverted | pyramid: how\n"
+        "                      triangle rows are aligned (default: left)\n"
+        "  -o, --output FILE   write to FILE instead of stdout\n"
+        "  -s, --sink NAME     auto | writev | splice | stdio | buffer |\n"
+        "                      mmap (default: auto)\n"
+        "  -j, --threads N     format large patterns on N threads "
+        "(default: 1)\n"
+        "  -f, --format NAME   text | framed | rle | raw | npy | pgm | ppm\n"
+        "                      (default: text); rle writes run-length\n"
+        "                      messages, raw and npy write concentric cell\n"
+        "                      values as binary arrays of the smallest\n"
+        "                      width, pgm and ppm as images\n"
+        "  -d, --decode        expand rle messages from stdin back to text\n"
+        "  -H, --huge MODE     off | thp | hugetlb: page size for the buffer\n"
+        "                      and mmap sinks (default: off)\n"
+        "  -F, --prefault      fault those in before rendering\n"
+        "  -P, --pin           pin the -j workers to CPUs node by node, so\n"
+        "                      each writes its rows to its own NUMA node\n"
+        "  -r, --profile FILE  engine thresholds for the auto sink\n"
+        "                      (default: $PATTERN_PROFILE, else\n"
+        "                      ~/.config/pattern-algorithms/profile)\n"
+        "  -A, --autotune      measure the engines on this machine (with\n"
+        "                      -j N for the pool), save the profile, exit\n"
+        "  -q, --quiet         do not report rejected requests\n"
+        "  -S, --stats         report CPU counters and format/write time\n"
+        "                      of every pattern on stderr\n"
+        "  -T, --self-test     check every kernel variant this CPU supports\n"
+        "                      against the scalar one, then exit\n"
+        "  -h, --help          show this help\n"
+        "\n"
+        "PATTERN_ISA=scalar|sse4.2|avx2|avx512 caps the kernel variant.\n",
+        cli->program, pattern_shape_names[cli->shape]);
+}
+
+static inline void pattern_cli_reject(pattern_cli *cli, const char *request,
+                                      const char *why) {
+    cli->rejected++;
+    if (!cli->quiet) {
+        fprintf(stderr, "%s: %s: %s\n", cli->program, request, why);
+    }
+}
+
+/**
+ * Parses the command line
+ *
+ * @return Index of the first size argument, or -1 on a usage error,
+ *         or 0 after --help
+ */
+static inline int pattern_cli_parse(pattern_cli *cli, int argc,
+                                    char **argv) {
+    static const struct option longopts[] = {
+        {"pattern", required_argument, NULL, 'p'},
+        {"variant", required_argument, NULL, 't'},
+        {"output",  required_argument, NULL, 'o'},
+        {"sink",    required_argument, NULL, 's'},
+        {"threads", required_argument, NULL, 'j'},
+        {"format",  required_argument, NULL, 'f'},
+        {"decode",  no_argument,       NULL, 'd'},
+        {"huge",    required_argument, NULL, 'H'},
+        {"prefault", no_argument,      NULL, 'F'},
+        {"pin",     no_argument,       NULL, 'P'},
+        {"profile", required_argument, NULL, 'r'},
+        {"autotune", no_argument,      NULL, 'A'},
+        {"quiet",   no_argument,       NULL, 'q'},
+        {"stats",   no_argument,       NULL, 'S'},
+        {"self-test", no_argument,     NULL, 'T'},
+        {"help",    no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "p:t:o:s:j:f:dH:FPr:AqSTh", longopts,
+                              NULL)) != -1) {
+        switch (opt) {
+        case 'p':
+            cli->shape = pattern_shape_parse(optarg);
+            if (cli->shape < 0) {
+                fprintf(stderr, "%s: unknown pattern '%s'\n",
+                        cli->program, optarg);
+                return -1;
+            }
+            break;
+        case 't':
+            cli->variant = triangle_variant_parse(optarg);
+            if (cli->variant < 0) {
+                fprintf(stderr, "%s: unknown triangle variant '%s'\n",
+                        cli->program, optarg);
+                return -1;
+            }
+            break;
+        case 'o':
+            cli->output = optarg;
+            break;
+        case 's':
+            if (strcmp(optarg, "auto") == 0) {
+                cli->sink = PATTERN_SINK_AUTO;
+            } else if (strcmp(optarg, "writev") == 0) {
+                cli->sink = PATTERN_SINK_WRITEV;
+            } else if (strcmp(optarg, "splice") == 0) {
+                cli->sink = PATTERN_SINK_SPLICE;
+            } else if (strcmp(optarg, "stdio") == 0) {
+                cli->sink = PATTERN_SINK_STDIO;
+            } else if (strcmp(optarg, "buffer") == 0) {
+                cli->sink = PATTERN_SINK_BUFFER;
+            } else if (strcmp(optarg, "mmap") == 0) {
+                cli->sink = PATTERN_SINK_MMAP;
+            } else {
+                fprintf(stderr, "%s: unknown sink '%s'\n",
+                        cli->program, optarg);
+                return -1;
+            }
+            break;
+        case 'j':
+            cli->threads = atoi(optarg);
+            if (cli->threads < 1 || cli->threads > PATTERN_MAX_THREADS) {
+                fprintf(stderr, "%s: threads must be 1..%d\n",
+                        cli->program, PATTERN_MAX_THREADS);
+                return -1;
+            }
+            break;
+        case 'f':
+            if (strcmp(optarg, "text") == 0) {
+                cli->format = PATTERN_FORMAT_TEXT;
+            } else if (strcmp(optarg, "framed") == 0) {
+                cli->format = PATTERN_FORMAT_FRAMED;
+            } else if (strcmp(optarg, "rle") == 0) {
+                cli->format = PATTERN_FORMAT_RLE;
+            } else if (strcmp(optarg, "raw") == 0) {
+                cli->format = PATTERN_FORMAT_RAW;
+            } else if (strcmp(optarg, "npy") == 0) {
+                cli->format = PATTERN_FORMAT_NPY;
+            } else if (strcmp(optarg, "pgm") == 0) {
+                cli->format = PATTERN_FORMAT_PGM;
+            } else if (strcmp(optarg, "ppm") == 0) {
+                cli->format = PATTERN_FORMAT_PPM;
+            } else {
+                fprintf(stderr, "%s: unknown format '%s'\n",
+                        cli->program, optarg);
+                return -1;
+            }
+            break;
+        case 'd':
+            cli->decode = 1;
+            break;
+        case 'H':
+            cli->pages = pattern_pages_parse(optarg);
+            if (cli->pages < 0) {
+                fprintf(stderr, "%s: unknown page mode '%s'\n",
+                        cli->program, optarg);
+                return -1;
+            }
+            break;
+        case 'F':
+            cli->prefault = 1;
+            break;
+        case 'P':
+            cli->pin = 1;
+            break;
+        case 'r':
+            cli->profile_path = optarg;
+            break;
+        case 'A':
+            cli->autotune = 1;
+            break;
+        case 'q':
+            cli->quiet = 1;
+            break;
+        case 'S':
+            cli->stats = 1;
+            break;
+        case 'T':
+            cli->self_test = 1;
+            break;
+        case 'h':
+            pattern_cli_usage(cli, stdout);
+            return 0;
+        default:
+            pattern_cli_usage(cli, stderr);
+            return -1;
+        }
+    }
+    return optind;
+}
+
+/**
+ * Runs pattern_kernels_check() on every variant this CPU supports
+ *
+ * @return Exit status: 0 if all of them match the scalar kernels
+ */
+static inline int pattern_cli_self_test(const pattern_cli *cli) {
+    int failed = 0;
+    printf("kernels: %s (best on this CPU: %s)\n",
+           pattern_isa_names[pattern_isa()],
+           pattern_isa_names[pattern_isa_detect()]);
+    for (int isa = 0; isa <= pattern_isa_detect(); isa++) {
+        int ok = pattern_kernels_check(isa) == 0;
+        printf("%-8s %s\n", pattern_isa_names[isa],
+               ok ? "ok" : "MISMATCH");
+        failed |= !ok;
+    }
+    int ok = concentric_aggregates_check() == 0;
+    printf("%-8s %s\n", "sums", ok ? "ok" : "MISMATCH");
+    failed |= !ok;
+    ok = concentric_compact_check() == 0;
+    printf("%-8s %s\n", "compact", ok ? "ok" : "MISMATCH");
+    failed |= !ok;
+    ok = pattern_rle_check() == 0;
+    printf("%-8s %s\n", "rle", ok ? "ok" : "MISMATCH");
+    failed |= !ok;
+    ok = pattern_table_check() == 0;
+    printf("%-8s %s\n", "tables", ok ? "ok" : "MISMATCH");
+    failed |= !ok;
+    ok = triangle_variants_check() == 0;
+    printf("%-8s %s\n", "variants", ok ? "ok" : "MISMATCH");
+    failed |= !ok;
+    if (failed) {
+        fprintf(stderr, "%s: kernel self-test failed\n", cli->program);
+    }
+    return failed ? 1 : 0;
+}
+
+/**
+ * Serves one request
+ *
+ * @param variant TRIANGLE_*; other shapes only take TRIANGLE_LEFT
+ * @param request Text of the request, for error messages
+ * @return 0 if the output is still healthy, -1 once it has failed
+ */
+static inline int pattern_cli_render(pattern_cli *cli, pattern_ctx *ctx,
+                                     int shape, int variant, size_t n,
+                                     const char *request) {
+    int (*reference)(int) = cli->reference[shape];
+    int binary = cli->format >= PATTERN_FORMAT_RAW;
+    int image = cli->format >= PATTERN_FORMAT_PGM;
+    int kind = cli->format == PATTERN_FORMAT_PGM ? PATTERN_IMAGE_PGM
+                                                 : PATTERN_IMAGE_PPM;
+    if (cli->sink == PATTERN_SINK_STDIO && reference == NULL) {
+        pattern_cli_reject(cli, request,
+                           "no stdio renderer for this pattern");
+        return 0;
+    }
+    if (binary && shape != PATTERN_CONCENTRIC) {
+        pattern_cli_reject(cli, request,
+                           "binary formats only export concentric squares");
+        return 0;
+    }
+    if (shape != PATTERN_TRIANGLE && variant != TRIANGLE_LEFT) {
+        pattern_cli_reject(cli, request,
+                           "variants only apply to triangles");
+        return 0;
+    }
+    if (variant != TRIANGLE_LEFT &&
+        (cli->format == PATTERN_FORMAT_RLE ||
+         cli->sink == PATTERN_SINK_STDIO ||
+         cli->sink == PATTERN_SINK_BUFFER ||
+         cli->sink == PATTERN_SINK_MMAP)) {
+        pattern_cli_reject(cli, request,
+                           "triangle variants are written as master slices: "
+                           "text or framed, auto/writev/splice sink");
+        return 0;
+    }
+    unsigned long long total = variant != TRIANGLE_LEFT
+                                   ? triangle_variant_total_bytes(variant, n)
+                                   : pattern_total_bytes(shape, n);
+
+    if (cli->format == PATTERN_FORMAT_FRAMED) {
+        char header[64];
+        int len = snprintf(header, sizeof(header), "%s %zu %llu\n",
+                           variant != TRIANGLE_LEFT
+                               ? triangle_variant_names[variant]
+                               : pattern_shape_names[shape],
+                           n, total);
+        if (cli->sink == PATTERN_SINK_STDIO) {
+            fputs(header, stdout);
+        } else if (pattern_ctx_copy(ctx, header, (size_t)len) != 0) {
+            return -1;
+        }
+    }
+
+    // With --stats the output is flushed after each pattern, so that its
+    // write syscalls fall inside its own measurement
+    int stdio = cli->sink == PATTERN_SINK_STDIO;
+    int memory = binary || cli->sink == PATTERN_SINK_BUFFER ||
+                 cli->sink == PATTERN_SINK_MMAP;
+    size_t packed = 0;
+    int failed;
+    if (cli->stats) {
+        pattern_stats_begin(&cli->perf, stdio ? NULL : &ctx->out);
+    }
+    if (stdio) {
+        // PATTERN_MAX_N fits in an int (print_triangle counts its stars
+        // in long long)
+        failed = reference((int)n) != 0 ||
+                 (cli->stats && fflush(stdout) != 0);
+        if (failed) {
+            ctx->out.error = errno;
+        }
+    } else if (variant != TRIANGLE_LEFT) {
+        failed = pattern_render_triangle(ctx, variant, n) != 0 ||
+                 (cli->stats && pattern_ctx_flush(ctx) != 0);
+    } else if (cli->format == PATTERN_FORMAT_RLE) {
+        packed = pattern_rle_emit(ctx, shape, n);
+        failed = packed == 0 ||
+                 (cli->stats && pattern_ctx_flush(ctx) != 0);
+    } else if (image) {
+        failed = pattern_image_write(ctx, kind, n,
+                                     cli->sink == PATTERN_SINK_MMAP) != 0;
+    } else if (binary) {
+        failed = pattern_matrix_write(ctx, n,
+                                      cli->format == PATTERN_FORMAT_NPY,
+                                      cli->sink == PATTERN_SINK_MMAP) != 0;
+    } else if (cli->sink == PATTERN_SINK_BUFFER) {
+        failed = pattern_render_memory(ctx, shape, n) != 0;
+    } else if (cli->sink == PATTERN_SINK_MMAP) {
+        failed = pattern_render_file(ctx, shape, n) != 0;
+    } else if (cli->sink == PATTERN_SINK_AUTO) {
+        failed = pattern_render_adaptive(ctx, &cli->profile, shape, n,
+                                         cli->mappable) != 0 ||
+                 (cli->stats && pattern_ctx_flush(ctx) != 0);
+    } else {
+        failed = pattern_render(ctx, shape, n) != 0 ||
+                 (cli->stats && pattern_ctx_flush(ctx) != 0);
+    }
+    if (cli->stats && !failed) {
+        pattern_stats_end(&cli->perf, stdio ? NULL : &ctx->out);
+        if (memory) {
+            cli->perf.pages = ctx->pages_used;
+        }
+        if (image) {
+            cli->perf.bytes = pattern_image_bytes(kind, n);
+        } else if (binary) {
+            cli->perf.bytes = pattern_matrix_bytes(n);
+        } else if (packed > 0) {
+            cli->perf.bytes = packed;
+        } else if (variant != TRIANGLE_LEFT) {
+            cli->perf.bytes = total;
+        }
+        pattern_stats_report(&cli->perf, stderr, shape, n);
+        if (memory) {
+            pattern_stats_nodes(ctx, stderr);
+        }
+    }
+    return failed ? -1 : 0;
+}
+
+/**
+ * Parses one stdin line ("n" or "<pattern> n") and serves it
+ *
+ * @return 0 if the output is still healthy, -1 once it has failed
+ */
+static inline int pattern_cli_line(pattern_cli *cli, pattern_ctx *ctx,
+                                   char *line) {
+    line[strcspn(line, "\r\n")] = '\0';
+    char *text = line + strspn(line, " \t");
+    if (*text == '\0' || *text == '#') {
+        return 0;
+    }
+
+    int shape = cli->shape;
+    int variant = cli->variant;
+    char *size = text;
+    char *space = strpbrk(text, " \t");
+    if (space != NULL && (text[0] < '0' || text[0] > '9')) {
+        *space = '\0';
+        shape = pattern_shape_parse(text);
+        size = space + 1 + strspn(space + 1, " \t");
+        if (shape < 0 && (variant = triangle_variant_parse(text)) >= 0) {
+            shape = PATTERN_TRIANGLE;
+        } else if (shape >= 0) {
+            // A pattern named on the line takes no -t variant
+            variant = TRIANGLE_LEFT;
+        }
+        if (shape < 0) {
+            *space = ' ';
+            pattern_cli_reject(cli, text, "unknown pattern");
+            return 0;
+        }
+    }
+
+    size_t n;
+    if (pattern_parse_size(size, &n) != 0) {
+        pattern_cli_reject(cli, text, "not a positive size");
+        return 0;
+    }
+    return pattern_cli_render(cli, ctx, shape, variant, n, text);
+}
+
+/**
+ * Runs a batch: parses argv, renders every request, returns exit status
+ */
+static inline int pattern_cli_main(pattern_cli *cli, int argc,
+                                   char **argv) {
+    // Report a closed pipe as EPIPE instead of dying on SIGPIPE
+    pattern_ignore_sigpipe();
+
+    int first = pattern_cli_parse(cli, argc, argv);
+    if (first <= 0) {
+        return first == 0 ? 0 : 1;
+    }
+    if (cli->self_test) {
+        return pattern_cli_self_test(cli);
+    }
+
+    char path_buf[PATTERN_PROFILE_PATH_MAX];
+    const char *profile = pattern_profile_path(cli->profile_path, path_buf);
+    pattern_profile_defaults(&cli->profile);
+    if (cli->autotune) {
+        if (profile == NULL) {
+            fprintf(stderr, "%s: no profile location: use --profile FILE\n",
+                    cli->program);
+            return 1;
+        }
+        if (pattern_tune_run(&cli->profile, cli->threads, stdout) != 0 ||
+            pattern_profile_save(&cli->profile, profile) != 0) {
+            fprintf(stderr, "%s: autotune failed: %s\n", cli->program,
+                    strerror(errno));
+            return 1;
+        }
+        printf("\n");
+        pattern_profile_print(&cli->profile, stdout);
+        printf("saved to %s\n", profile);
+        return 0;
+    }
+    if (profile != NULL &&
+        pattern_profile_load(&cli->profile, profile) < 0) {
+        // A broken profile costs speed, not output: keep the defaults
+        fprintf(stderr, "%s: %s: %s, using defaults\n", cli->program,
+                profile, strerror(errno));
+        pattern_profile_defaults(&cli->profile);
+    }
+    int binary = cli->format >= PATTERN_FORMAT_RAW;
+    if ((binary || cli->format == PATTERN_FORMAT_RLE) &&
+        cli->sink == PATTERN_SINK_STDIO) {
+        fprintf(stderr, "%s: the stdio sink only writes text\n",
+                cli->program);
+        return 1;
+    }
+    if (cli->decode && first < argc) {
+        fprintf(stderr, "%s: --decode reads stdin and takes no sizes\n",
+                cli->program);
+        return 1;
+    }
+
+    if (cli->output != NULL && strcmp(cli->output, "-") != 0) {
+        // Shared writable mappings need the file open for reading too
+        int mode = cli->sink == PATTERN_SINK_MMAP ||
+                           cli->sink == PATTERN_SINK_AUTO
+                       ? O_RDWR
+                       : O_WRONLY;
+        int fd = open(cli->output, mode | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || dup2(fd, STDOUT_FILENO) < 0) {
+            fprintf(stderr, "%s: %s: %s\n", cli->program, cli->output,
+                    strerror(errno));
+            return 1;
+        }
+        close(fd);
+    }
+    struct stat out;
+    cli->mappable = cli->sink == PATTERN_SINK_AUTO &&
+                    fstat(STDOUT_FILENO, &out) == 0 &&
+                    S_ISREG(out.st_mode) &&
+                    (fcntl(STDOUT_FILENO, F_GETFL) & O_ACCMODE) == O_RDWR;
+    if (binary && cli->mappable) {
+        // Arrays and images go into a regular file through a mapping
+        cli->sink = PATTERN_SINK_MMAP;
+    }
+    if (cli->sink == PATTERN_SINK_MMAP &&
+        (fstat(STDOUT_FILENO, &out) != 0 || !S_ISREG(out.st_mode) ||
+         (fcntl(STDOUT_FILENO, F_GETFL) & O_ACCMODE) != O_RDWR)) {
+        fprintf(stderr, "%s: the mmap sink needs a regular file open for "
+                        "reading and writing (-o FILE, or 1<>FILE)\n",
+                cli->program);
+        return 1;
+    }
+
+    // Counters first: the render pool's threads inherit them
+    if (cli->stats) {
+        pattern_stats_open(&cli->perf);
+    }
+
+    pattern_ctx ctx;
+    int sink = cli->sink;
+    if (sink == PATTERN_SINK_STDIO || sink == PATTERN_SINK_MMAP) {
+        sink = PATTERN_SINK_WRITEV;
+    } else if (sink == PATTERN_SINK_BUFFER || sink == PATTERN_SINK_AUTO) {
+        // The profile picks the pipe sink; anything else gets writev
+        sink = cli->profile.pipe_sink;
+    }
+    if (pattern_ctx_init(&ctx, STDOUT_FILENO, sink, cli->threads) != 0) {
+        fprintf(stderr, "%s: out of memory\n", cli->program);
+        pattern_ctx_close(&ctx);
+        return 1;
+    }
+    ctx.pages = cli->pages;
+    ctx.populate = cli->prefault;
+    ctx.parallel_min = cli->profile.parallel_min < SIZE_MAX
+                           ? (size_t)cli->profile.parallel_min
+                           : SIZE_MAX;
+    int pin_error = cli->pin ? pattern_ctx_pin(&ctx) : 0;
+    if (pin_error != 0) {
+        fprintf(stderr, "%s: cannot pin workers: %s\n", cli->program,
+                strerror(pin_error));
+    }
+
+    int failed = 0;
+    if (cli->decode) {
+        int decoded = pattern_rle_decode(&ctx, STDIN_FILENO);
+        if (decoded == PATTERN_RLE_MALFORMED) {
+            pattern_cli_reject(cli, "stdin", "not a valid rle stream");
+        }
+        failed = decoded == -1;
+    } else if (first < argc) {
+        for (int a = first; a < argc && !failed; a++) {
+            size_t n;
+            if (pattern_parse_size(argv[a], &n) != 0) {
+                pattern_cli_reject(cli, argv[a], "not a positive size");
+                continue;
+            }
+            failed = pattern_cli_render(cli, &ctx, cli->shape,
+                                        cli->variant, n, argv[a]) != 0;
+        }
+    } else {
+        char *line = NULL;
+        size_t cap = 0;
+        while (!failed && getline(&line, &cap, stdin) != -1) {
+            failed = pattern_cli_line(cli, &ctx, line) != 0;
+        }
+        free(line);
+    }
+
+    if (cli->sink == PATTERN_SINK_STDIO && fflush(stdout) != 0 &&
+        ctx.out.error == 0) {
+        ctx.out.error = errno;
+    }
+    int err = pattern_ctx_close(&ctx);
+    if (cli->stats) {
+        pattern_stats_close(&cli->perf);
+    }
+    if (err != 0) {
+        if (err != EPIPE) {
+            fprintf(stderr, "%s: write failed: %s\n", cli->program,
+                    strerror(err));
+        }
+        return pattern_output_status(err);
+    }
+    return cli->rejected ? 1 : 0;
+}
+
+#endif // PATTERN_CLI_H
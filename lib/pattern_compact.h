@@ -0,0 +1,200 @@
+/**
+ * pattern_compact.h
+ *
+ * Concentric squares stored as their two number ladders, expanded on
+ * demand.
+ *
+ * Every row of the square is its middle row
+ *
+ *   n n-1 ... 2 1 2 ... n-1 n
+ *
+ * with the middle replaced by a plateau fill (see pattern_concentric.h).
+ * That row is the two ladders of concentric_master, so a
+ * concentric_compact is nothing more than n and a concentric_master
+ * sized for exactly n: a ladder cache of 2·S(n) bytes, S(n) as in
+ * concentric_ladder_bytes (under 7n for n below a million, so under 14n
+ * for both ladders), plus page rounding. The text takes about
+ * 4n²·(digits(n)+1): n = 10,000 is 98 KB against 2.2 GB. It is not a
+ * stored octant; it is what the renderers already keep, shared.
+ *
+ * Expansions, each costing as much as its output:
+ *
+ *   concentric_compact_row()     one row of text
+ *   concentric_compact_range()   any byte range of the text (tiles of
+ *                                bytes, Range requests)
+ *   concentric_compact_cells()   a rows × cols tile of cell values
+ *   concentric_compact_expand()  the whole text
+ *
+ * A compact square is immutable once built and never written again, so
+ * any number of threads can expand from it, and its ladders may be
+ * referenced by vmsplice like the masters of a pattern_ctx.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_COMPACT_H
+#define PATTERN_COMPACT_H
+
+#include <stdio.h>
+
+#include "pattern_render.h"
+
+typedef struct concentric_compact {
+    size_t n;
+    concentric_master master;   // ladders for exactly n
+} concentric_compact;
+
+/**
+ * Builds the compact form of the square for n
+ *
+ * @return 0 on success, -1 if memory could not be mapped
+ */
+static inline int concentric_compact_init(concentric_compact *cc,
+                                          size_t n) {
+    memset(cc, 0, sizeof(*cc));
+    cc->n = n;
+    return concentric_master_reserve(&cc->master, n);
+}
+
+static inline void concentric_compact_free(concentric_compact *cc) {
+    concentric_master_free(&cc->master);
+    cc->n = 0;
+}
+
+/**
+ * Memory held by a compact square, for cache budgets
+ */
+static inline size_t concentric_compact_footprint(
+        const concentric_compact *cc) {
+    return sizeof(*cc) + cc->master.map_size;
+}
+
+/**
+ * Bytes of the expanded text
+ */
+static inline unsigned long long concentric_compact_bytes(
+        const concentric_compact *cc) {
+    return concentric_total_bytes(cc->n);
+}
+
+/**
+ * Writes row k of the text
+ *
+ * @return Bytes written
+ */
+static inline size_t concentric_compact_row(const concentric_compact *cc,
+                                            size_t k, char *dst) {
+    return concentric_render_row(dst, &cc->master, cc->n,
+                                 concentric_row_plateau(cc->n, k), 0);
+}
+
+/**
+ * Writes bytes [offset, offset+len) of the text; the range must lie
+ * within concentric_compact_bytes()
+ */
+static inline void concentric_compact_range(const concentric_compact *cc,
+                                            unsigned long long offset,
+                                            size_t len, char *dst) {
+    size_t n = cc->n;
+    size_t k = pattern_find_row(PATTERN_CONCENTRIC, n, offset);
+    size_t from = (size_t)(offset - concentric_row_offset(n, k));
+
+    while (len > 0) {
+        size_t p = concentric_row_plateau(n, k);
+        size_t row = (size_t)concentric_row_bytes(n, p);
+        size_t count = row - from < len ? row - from : len;
+        concentric_render_span(dst, &cc->master, n, p, from, count);
+        dst += count;
+        len -= count;
+        from = 0;
+        k++;
+    }
+}
+
+/**
+ * Writes the values of rows [i, i+rows) × columns [j, j+cols), row after
+ * row; the tile must lie within the (2n-1)×(2n-1) square
+ */
+static inline void concentric_compact_cells(const concentric_compact *cc,
+                                            size_t i, size_t j, size_t rows,
+                                            size_t cols, uint32_t *dst) {
+    for (size_t r = 0; r < rows; r++) {
+        concentric_cell_row(dst + r * cols, cc->n, i + r, j, cols);
+    }
+}
+
+/**
+ * Writes the whole text
+ *
+ * @param dst concentric_compact_bytes() bytes
+ */
+static inline void concentric_compact_expand(const concentric_compact *cc,
+                                             char *dst) {
+    for (size_t k = 0; k < 2 * cc->n - 1; k++) {
+        dst += concentric_compact_row(cc, k, dst);
+    }
+}
+
+/**
+ * Checks every expansion against cell values for n = 1..12: the text row
+ * by row, every byte range of it, and every tile
+ *
+ * @return 0 if all of them match, -1 otherwise
+ */
+static inline int concentric_compact_check(void) {
+    enum { CHECK_MAX = 12, SIDE = 2 * CHECK_MAX - 1 };
+    static char want[SIDE * (SIDE * 3 + 1)];
+    static char got[sizeof(want)];
+    uint32_t cells[SIDE * SIDE];
+
+    for (size_t n = 1; n <= CHECK_MAX; n++) {
+        size_t side = 2 * n - 1;
+        size_t len = 0;
+        for (size_t i = 0; i < side; i++) {
+            for (size_t j = 0; j < side; j++) {
+                len += (size_t)sprintf(want + len, "%u ",
+                                       concentric_cell((int32_t)n,
+                                                       (int32_t)i,
+                                                       (int32_t)j));
+            }
+            want[len++] = '\n';
+        }
+
+        concentric_compact cc;
+        if (concentric_compact_init(&cc, n) != 0) {
+            return -1;
+        }
+        int failed = concentric_compact_bytes(&cc) != len;
+        if (!failed) {
+            concentric_compact_expand(&cc, got);
+            failed = memcmp(got, want, len) != 0;
+        }
+        for (size_t off = 0; off < len && !failed; off++) {
+            for (size_t count = 1; off + count <= len && !failed;
+                 count += 7) {
+                concentric_compact_range(&cc, off, count, got);
+                failed = memcmp(got, want + off, count) != 0;
+            }
+        }
+        for (size_t t = 0; t < side * side && !failed; t++) {
+            size_t i = t / side, j = t % side;
+            size_t rows = side - i, cols = side - j;
+            concentric_compact_cells(&cc, i, j, rows, cols, cells);
+            for (size_t c = 0; c < rows * cols && !failed; c++) {
+                failed = cells[c] !=
+                         concentric_cell((int32_t)n,
+                                         (int32_t)(i + c / cols),
+                                         (int32_t)(j + c % cols));
+            }
+        }
+        concentric_compact_free(&cc);
+        if (failed) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif // PATTERN_COMPACT_H
@@ -0,0 +1,546 @@
+/**
+ * pattern_concentric.h
+ *
+ * Concentric square rendering on top of the shared output layer.
+ *
+ * Row i of the (2n-1)×(2n-1) square is at ring distance ri = |i - (n-1)|
+ * from the center row, and its "plateau" value is p = ri + 1. Reading the
+ * diagonal decomposition of print_concentric_square() row by row, every
+ * row has the same three-part shape:
+ *
+ *   n n-1 ... p+1 | p p ... p (2p-1 times) | p+1 ... n-1 n
+ *   upper-left      the flat run             lower-right
+ *
+ * The outer parts only depend on p, and they are a slice of the
+ * descending ladder "N N-1 ... 1 " and of the ascending ladder
+ * "1 2 ... N " for any N >= n. Both ladders are formatted once for the
+ * largest n seen, so each row is one reference, one repeated-token fill,
+ * one reference and a newline, and rows i and 2n-2-i (same ri) come out
+ * identical by construction.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_CONCENTRIC_H
+#define PATTERN_CONCENTRIC_H
+
+#include <stdint.h>
+
+#include "pattern_io.h"
+
+/**
+ * Formatted ladders, in a single mapping, for every n up to `n`
+ */
+typedef struct concentric_master {
+    char *desc;         // "N N-1 ... 2 1 "
+    char *asc;          // "1 2 ... N-1 N "
+    size_t n;           // largest n the ladders can serve (N)
+    size_t ladder;      // bytes in each ladder
+    size_t map_size;
+} concentric_master;
+
+/**
+ * Number of decimal digits in v (v >= 1)
+ */
+static inline unsigned concentric_digits(unsigned long long v) {
+    unsigned d = 1;
+    while (v >= 10) {
+        v /= 10;
+        d++;
+    }
+    return d;
+}
+
+/**
+ * Writes the token "v " and returns its length
+ */
+static inline size_t concentric_format_token(char *dst,
+                                             unsigned long long v) {
+    unsigned d = concentric_digits(v);
+    for (unsigned k = d; k > 0; k--) {
+        dst[k - 1] = (char)('0' + v % 10);
+        v /= 10;
+    }
+    dst[d] = ' ';
+    return d + 1;
+}
+
+/**
+ * Bytes in the ladder "1 2 ... p ", summed one digit-decade at a time:
+ * S(p) = sum of (digits(v) + 1) for v = 1..p
+ */
+static inline unsigned long long concentric_ladder_bytes(
+        unsigned long long p) {
+    unsigned long long total = 0;
+    unsigned long long lo = 1;
+    for (unsigned d = 1; lo <= p; d++, lo *= 10) {
+        unsigned long long hi = lo * 10 - 1;
+        if (hi > p) {
+            hi = p;
+        }
+        total += (hi - lo + 1) * (d + 1);
+    }
+    return total;
+}
+
+/**
+ * Plateau value of row k (0-based): n, n-1, ..., 2, 1, 2, ..., n
+ */
+static inline size_t concentric_row_plateau(size_t n, size_t k) {
+    return k < n ? n - k : k - n + 2;
+}
+
+/**
+ * Value of cell (i, j) of the square for n, without branches
+ *
+ * Same diagonal decomposition as print_concentric_square(): cells with
+ * i + j < m (m = 2n-1) take max(n-i, n-j) = n - min(i, j), the others
+ * max(i-n, j-n) + 2 = max(i, j) - n + 2. Both are evaluated, and the
+ * min/max and the region are picked with masks built from comparisons,
+ * which compile to setcc and logic ops rather than jumps. The region
+ * boundary moves one column per row, which costs the branchy loop a
+ * misprediction per row, and one per cell or so under random access;
+ * here there is nothing to predict, and a row loop over j vectorizes.
+ *
+ * 32-bit arithmetic keeps more lanes per vector; i + j stays below 2^31
+ * for every n up to PATTERN_MAX_N.
+ */
+static inline uint32_t concentric_cell(int32_t n, int32_t i, int32_t j) {
+    int32_t lo = j ^ ((i ^ j) & -(int32_t)(i < j));
+    int32_t hi = i ^ j ^ lo;
+    int32_t upper = n - lo;
+    int32_t lower = hi - n + 2;
+    int32_t in_upper = -(int32_t)(i + j < 2 * n - 1);
+    return (uint32_t)(lower ^ ((upper ^ lower) & in_upper));
+}
+
+/**
+ * Values of cells (i, from) .. (i, from + count - 1), one at a time
+ */
+static inline void concentric_cell_row_scalar(uint32_t *dst, size_t n,
+                                              size_t i, size_t from,
+                                              size_t count) {
+    for (size_t j = 0; j < count; j++) {
+        dst[j] = concentric_cell((int32_t)n, (int32_t)i,
+                                 (int32_t)(from + j));
+    }
+}
+
+#if PATTERN_SIMD_X86
+
+/*
+ * Vector variants of concentric_cell_row_scalar(): the same formula on
+ * a vector of consecutive j, with min/max instructions for the region
+ * values and a compare-and-blend for the region choice.
+ */
+__attribute__((target("sse4.2"))) static void concentric_cell_row_sse42(
+        uint32_t *dst, size_t n, size_t i, size_t from, size_t count) {
+    __m128i vn = _mm_set1_epi32((int32_t)n);
+    __m128i vi = _mm_set1_epi32((int32_t)i);
+    __m128i edge = _mm_set1_epi32((int32_t)(2 * n - 1));
+    __m128i two = _mm_set1_epi32(2);
+    __m128i vj = _mm_add_epi32(_mm_set1_epi32((int32_t)from),
+                               _mm_setr_epi32(0, 1, 2, 3));
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m128i upper = _mm_sub_epi32(vn, _mm_min_epi32(vi, vj));
+        __m128i lower = _mm_add_epi32(_mm_sub_epi32(_mm_max_epi32(vi, vj),
+                                                    vn), two);
+        __m128i in_upper = _mm_cmpgt_epi32(edge, _mm_add_epi32(vi, vj));
+        _mm_storeu_si128((__m128i *)(dst + j),
+                         _mm_blendv_epi8(lower, upper, in_upper));
+        vj = _mm_add_epi32(vj, _mm_set1_epi32(4));
+    }
+    concentric_cell_row_scalar(dst + j, n, i, from + j, count - j);
+}
+
+__attribute__((target("avx2"))) static void concentric_cell_row_avx2(
+        uint32_t *dst, size_t n, size_t i, size_t from, size_t count) {
+    __m256i vn = _mm256_set1_epi32((int32_t)n);
+    __m256i vi = _mm256_set1_epi32((int32_t)i);
+    __m256i edge = _mm256_set1_epi32((int32_t)(2 * n - 1));
+    __m256i two = _mm256_set1_epi32(2);
+    __m256i vj = _mm256_add_epi32(_mm256_set1_epi32((int32_t)from),
+                                  _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m256i upper = _mm256_sub_epi32(vn, _mm256_min_epi32(vi, vj));
+        __m256i lower = _mm256_add_epi32(
+            _mm256_sub_epi32(_mm256_max_epi32(vi, vj), vn), two);
+        __m256i in_upper = _mm256_cmpgt_epi32(edge, _mm256_add_epi32(vi, vj));
+        _mm256_storeu_si256((__m256i *)(dst + j),
+                            _mm256_blendv_epi8(lower, upper, in_upper));
+        vj = _mm256_add_epi32(vj, _mm256_set1_epi32(8));
+    }
+    concentric_cell_row_scalar(dst + j, n, i, from + j, count - j);
+}
+
+// The tail is a masked store instead of a scalar loop
+__attribute__((target("avx512f"))) static void concentric_cell_row_avx512(
+        uint32_t *dst, size_t n, size_t i, size_t from, size_t count) {
+    __m512i vn = _mm512_set1_epi32((int32_t)n);
+    __m512i vi = _mm512_set1_epi32((int32_t)i);
+    __m512i edge = _mm512_set1_epi32((int32_t)(2 * n - 1));
+    __m512i two = _mm512_set1_epi32(2);
+    __m512i vj = _mm512_add_epi32(
+        _mm512_set1_epi32((int32_t)from),
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                          15));
+    for (size_t j = 0; j < count; j += 16) {
+        __m512i upper = _mm512_sub_epi32(vn, _mm512_min_epi32(vi, vj));
+        __m512i lower = _mm512_add_epi32(
+            _mm512_sub_epi32(_mm512_max_epi32(vi, vj), vn), two);
+        __mmask16 in_upper =
+            _mm512_cmpgt_epi32_mask(edge, _mm512_add_epi32(vi, vj));
+        __mmask16 keep = count - j >= 16
+                             ? (__mmask16)0xffff
+                             : (__mmask16)((1u << (count - j)) - 1);
+        _mm512_mask_storeu_epi32(dst + j, keep,
+                                 _mm512_mask_blend_epi32(in_upper, lower,
+                                                         upper));
+        vj = _mm512_add_epi32(vj, _mm512_set1_epi32(16));
+    }
+}
+
+static void (*const concentric_cell_row_variants[PATTERN_ISAS])(
+        uint32_t *, size_t, size_t, size_t, size_t) = {
+    concentric_cell_row_scalar,
+    concentric_cell_row_sse42,
+    concentric_cell_row_avx2,
+    concentric_cell_row_avx512,
+};
+
+#else
+
+static void (*const concentric_cell_row_variants[PATTERN_ISAS])(
+        uint32_t *, size_t, size_t, size_t, size_t) = {
+    concentric_cell_row_scalar,
+    concentric_cell_row_scalar,
+    concentric_cell_row_scalar,
+    concentric_cell_row_scalar,
+};
+
+#endif // PATTERN_SIMD_X86
+
+/**
+ * Values of cells (i, from) .. (i, from + count - 1), with the kernel
+ * variant for this CPU (see pattern_simd.h)
+ */
+static inline void concentric_cell_row(uint32_t *dst, size_t n, size_t i,
+                                       size_t from, size_t count) {
+    concentric_cell_row_variants[pattern_isa()](dst, n, i, from, count);
+}
+
+/**
+ * Bytes in a row with plateau value p: both outer runs (tokens p+1..n),
+ * the flat run of 2p-1 tokens "p " and the newline
+ */
+static inline unsigned long long concentric_row_bytes(size_t n, size_t p) {
+    unsigned long long outer = concentric_ladder_bytes(n) -
+                               concentric_ladder_bytes(p);
+    return 2 * outer +
+           (2ULL * p - 1) * (concentric_digits(p) + 1) + 1;
+}
+
+/**
+ * Total output bytes for n, in closed form per digit-decade
+ *
+ * Ring v (the cells holding value v) has 8(v-1) cells for v >= 2 and a
+ * single cell for v = 1, and each cell is digits(v)+1 bytes. Summing
+ * 8(v-1) over v = lo..hi gives 4(hi-lo+1)(lo+hi-2). Add one newline per
+ * row of the 2n-1 rows.
+ */
+static inline unsigned long long concentric_total_bytes(
+        unsigned long long n) {
+    if (n == 0) {
+        return 0;
+    }
+    unsigned long long total = 2 + (2 * n - 1);   // center "1 " + newlines
+    unsigned long long lo = 2;
+    for (unsigned d = 1; lo <= n; d++) {
+        unsigned long long hi = d == 1 ? 9 : lo * 10 - 1;
+        if (hi > n) {
+            hi = n;
+        }
+        total += 4 * (hi - lo + 1) * (lo + hi - 2) * (d + 1);
+        lo = d == 1 ? 10 : lo * 10;
+    }
+    return total;
+}
+
+/**
+ * Prefix sums over plateau values used to locate rows in closed form:
+ *   A(P) = sum of S(p)                  for p = 1..P
+ *   B(P) = sum of (2p-1)(digits(p)+1)   for p = 1..P
+ * Inside one digit-decade S(p) grows linearly and digits(p) is fixed, so
+ * both sums are arithmetic series per decade.
+ */
+static inline void concentric_plateau_sums(unsigned long long P,
+                                           unsigned long long *A,
+                                           unsigned long long *B) {
+    unsigned long long a = 0;
+    unsigned long long b = 0;
+    unsigned long long below = 0;       // S(lo - 1)
+    unsigned long long lo = 1;
+    for (unsigned d = 1; lo <= P; d++, lo *= 10) {
+        unsigned long long hi = lo * 10 - 1;
+        if (hi > P) {
+            hi = P;
+        }
+        unsigned long long cnt = hi - lo + 1;
+        a += cnt * below + (d + 1) * (cnt * (cnt + 1) / 2);
+        b += cnt * (lo + hi - 1) * (d + 1);
+        below += cnt * (d + 1);
+    }
+    *A = a;
+    *B = b;
+}
+
+/**
+ * Bytes in all rows whose plateau value lies in [p1, p2], one row each
+ */
+static inline unsigned long long concentric_rows_bytes(unsigned long long n,
+                                                       unsigned long long p1,
+                                                       unsigned long long p2) {
+    if (p1 > p2) {
+        return 0;
+    }
+    unsigned long long a_hi, b_hi, a_lo, b_lo;
+    concentric_plateau_sums(p2, &a_hi, &b_hi);
+    concentric_plateau_sums(p1 - 1, &a_lo, &b_lo);
+    unsigned long long row_fixed = 2 * concentric_ladder_bytes(n) + 1;
+    return (p2 - p1 + 1) * row_fixed - 2 * (a_hi - a_lo) + (b_hi - b_lo);
+}
+
+/**
+ * Byte offset of row k (0-based), without walking the rows above it
+ *
+ * Rows 0..k-1 of the upper half have plateaus n-k+1..n; below the middle
+ * row the lower half adds plateaus 2..k-n+1.
+ */
+static inline unsigned long long concentric_row_offset(unsigned long long n,
+                                                       unsigned long long k) {
+    if (k <= n) {
+        return concentric_rows_bytes(n, n - k + 1, n);
+    }
+    return concentric_rows_bytes(n, 1, n) +
+           concentric_rows_bytes(n, 2, k - n + 1);
+}
+
+/**
+ * Makes sure the ladders cover n
+ *
+ * Larger ladders go into a fresh mapping and the old one is unmapped,
+ * never rewritten in place (see the vmsplice lifetime rules in
+ * pattern_io.h). Smaller n reuse the existing ladders.
+ *
+ * @return 0 on success, -1 if memory could not be mapped
+ */
+static inline int concentric_master_reserve(concentric_master *cm,
+                                            size_t n) {
+    if (n <= cm->n) {
+        return 0;
+    }
+
+    size_t ladder = (size_t)concentric_ladder_bytes(n);
+    size_t map_size = pattern_page_round(2 * ladder);
+    char *base = pattern_map(map_size);
+    if (base == NULL) {
+        return -1;
+    }
+
+    char *desc = base;
+    char *asc = base + ladder;
+    size_t at = 0;
+    for (size_t v = 1; v <= n; v++) {
+        at += concentric_format_token(asc + at, v);
+    }
+
+    // The descending ladder is the ascending one with its tokens reversed
+    size_t from = ladder;
+    at = 0;
+    for (size_t v = 1; v <= n; v++) {
+        size_t len = concentric_digits(v) + 1;
+        from -= len;
+        memcpy(desc + from, asc + at, len);
+        at += len;
+    }
+
+    pattern_unmap(cm->desc, cm->map_size);
+    cm->desc = desc;
+    cm->asc = asc;
+    cm->n = n;
+    cm->ladder = ladder;
+    cm->map_size = map_size;
+    return 0;
+}
+
+static inline void concentric_master_free(concentric_master *cm) {
+    pattern_unmap(cm->desc, cm->map_size);
+    memset(cm, 0, sizeof(*cm));
+}
+
+/**
+ * Slices of the ladders forming the outer runs of a row
+ *
+ * The left run n, n-1, ..., p+1 is the part of "N ... 1 " between the
+ * tokens for N and p, the right run p+1, ..., n the matching part of
+ * "1 ... N ". Both are S(n) - S(p) bytes long.
+ */
+static inline size_t concentric_outer_runs(const concentric_master *cm,
+                                           size_t n, size_t p,
+                                           const char **left,
+                                           const char **right) {
+    size_t ladder_n = (size_t)concentric_ladder_bytes(n);
+    size_t inner = (size_t)concentric_ladder_bytes(p);
+    *left = cm->desc + (cm->ladder - ladder_n);
+    *right = cm->asc + inner;
+    return ladder_n - inner;
+}
+
+/**
+ * Fills the flat run: the token "p " repeated 2p-1 times
+ *
+ * @param stream Use non-temporal stores (see pattern_fill_mode)
+ * @return Bytes written
+ */
+static inline size_t concentric_fill_plateau(char *dst, size_t p,
+                                             int stream) {
+    char token[24];
+    size_t token_len = concentric_format_token(token, p);
+    size_t run = token_len * (2 * p - 1);
+    pattern_fill_mode(dst, token, token_len, run, stream);
+    return run;
+}
+
+/**
+ * Formats the row with plateau value p into memory
+ *
+ * The ladders must already cover n.
+ *
+ * @param stream Use non-temporal stores, for output far larger than the
+ *               cache; the caller issues pattern_stream_fence()
+ * @return Bytes written (concentric_row_bytes(n, p))
+ */
+static inline size_t concentric_render_row(char *dst,
+                                           const concentric_master *cm,
+                                           size_t n, size_t p, int stream) {
+    const char *left;
+    const char *right;
+    size_t outer = concentric_outer_runs(cm, n, p, &left, &right);
+
+    char *at = dst;
+    pattern_copy(at, left, outer, stream);
+    at += outer;
+    at += concentric_fill_plateau(at, p, stream);
+    pattern_copy(at, right, outer, stream);
+    at += outer;
+    *at++ = '\n';
+    return (size_t)(at - dst);
+}
+
+/**
+ * Formats bytes [from, from+len) of the row with plateau value p
+ *
+ * Random-access version of concentric_render_row(): the outer runs are
+ * copied from the ladders at the right offset and the flat run is
+ * started mid-token when `from` falls inside it, so a byte range costs
+ * O(len) no matter where in the row it starts.
+ */
+static inline void concentric_render_span(char *dst,
+                                          const concentric_master *cm,
+                                          size_t n, size_t p,
+                                          size_t from, size_t len) {
+    const char *left;
+    const char *right;
+    size_t outer = concentric_outer_runs(cm, n, p, &left, &right);
+    char token[24];
+    size_t token_len = concentric_format_token(token, p);
+    size_t run = token_len * (2 * p - 1);
+    size_t end = from + len;
+    size_t pos = from;
+
+    if (pos < end && pos < outer) {
+        size_t count = (end < outer ? end : outer) - pos;
+        memcpy(dst, left + pos, count);
+        dst += count;
+        pos += count;
+    }
+    if (pos < end && pos < outer + run) {
+        size_t count = (end < outer + run ? end : outer + run) - pos;
+        // The run seen from `pos` repeats the token rotated to its phase
+        size_t phase = (pos - outer) % token_len;
+        char rotated[24];
+        memcpy(rotated, token + phase, token_len - phase);
+        memcpy(rotated + token_len - phase, token, phase);
+        pattern_fill(dst, rotated, token_len, count);
+        dst += count;
+        pos += count;
+    }
+    if (pos < end && pos < 2 * outer + run) {
+        size_t count = (end < 2 * outer + run ? end : 2 * outer + run) - pos;
+        memcpy(dst, right + (pos - outer - run), count);
+        dst += count;
+        pos += count;
+    }
+    if (pos < end) {
+        *dst = '\n';
+    }
+}
+
+/**
+ * Emits the row with plateau value p through the writer
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int concentric_write_row(pattern_writer *w,
+                                       const concentric_master *cm,
+                                       size_t n, size_t p) {
+    const char *left;
+    const char *right;
+    size_t outer = concentric_outer_runs(cm, n, p, &left, &right);
+
+    if (pattern_writer_ref(w, left, outer) != 0) {
+        return -1;
+    }
+
+    size_t token_len = concentric_digits(p) + 1;
+    char *dst = pattern_writer_reserve(w, token_len * (2 * p - 1));
+    if (dst == NULL ||
+        pattern_writer_commit(w, concentric_fill_plateau(dst, p, 0)) != 0) {
+        return -1;
+    }
+
+    if (pattern_writer_ref(w, right, outer) != 0) {
+        return -1;
+    }
+    return pattern_writer_copy(w, "\n", 1);
+}
+
+/**
+ * Emits the (2n-1)×(2n-1) concentric square for n
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int concentric_write(pattern_writer *w, concentric_master *cm,
+                                   size_t n) {
+    // Queued rows may still point into a master about to be unmapped
+    if (n > cm->n && pattern_writer_flush(w) != 0) {
+        return -1;
+    }
+    if (concentric_master_reserve(cm, n) != 0) {
+        w->error = ENOMEM;
+        return -1;
+    }
+    for (size_t k = 0; k < 2 * n - 1; k++) {
+        if (concentric_write_row(w, cm, n,
+                                 concentric_row_plateau(n, k)) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif // PATTERN_CONCENTRIC_H
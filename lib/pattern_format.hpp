@@ -0,0 +1,482 @@
+/**
+ * pattern_format.hpp
+ *
+ * Both patterns with a custom glyph, separator, alignment and cell
+ * width, chosen at compile time, for C++17 and later.
+ *
+ * triangle.c prints "* " and concentric_square.c prints "%d "; here
+ * those pieces are policies, and each combination is its own renderer:
+ *
+ *   #include "pattern_format.hpp"
+ *
+ *   using blocks = pattern::triangle_format<pattern::full_block,
+ *                                           pattern::no_separator>;
+ *   blocks::write(STDOUT_FILENO, 5);            // █, ██, ███, ...
+ *
+ *   using grid = pattern::concentric_format<pattern::space,
+ *                                           pattern::align_right,
+ *                                           pattern::column_width>;
+ *   std::string text = grid::text(12);          // columns line up
+ *
+ * A glyph or separator is any type with a constexpr std::string_view
+ * `text`. utf8_glyph<U'★'> encodes a code point to its UTF-8 bytes at
+ * compile time, so a multibyte glyph is as cheap as '*': the token
+ * (glyph then separator) is a constexpr array whose length is a
+ * constant in every size and offset computation.
+ *
+ * The renderers use the same layouts as the C engines. A triangle row
+ * is a suffix of one master row of n tokens and a newline, so write()
+ * formats the master once and sends the rows as writev(2) slices of it.
+ * A concentric row is a prefix of the descending ladder, a plateau of
+ * one repeated cell, and a suffix of the ascending ladder; both ladders
+ * are formatted once and each row is assembled with three copies. With
+ * the default policies the output is byte for byte that of the
+ * programs.
+ *
+ * Compile: g++ -std=c++17 -O2 program.cpp
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_FORMAT_HPP
+#define PATTERN_FORMAT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Output gathered per writev(2) call, and per write of assembled rows
+#define PATTERN_FORMAT_IOV   1024
+#define PATTERN_FORMAT_CHUNK (64u << 10)
+
+namespace pattern {
+
+/* ------------------------------------------------------------------ */
+/* Policies                                                            */
+/* ------------------------------------------------------------------ */
+
+namespace detail {
+
+/**
+ * UTF-8 encoding of code point C, computed by the compiler
+ */
+template <char32_t C>
+constexpr auto utf8_encode() {
+    static_assert(C < 0x110000 && (C < 0xD800 || C > 0xDFFF),
+                  "not a Unicode scalar value");
+    constexpr std::size_t len = C < 0x80 ? 1 : C < 0x800 ? 2
+                              : C < 0x10000 ? 3 : 4;
+    std::array<char, len> bytes{};
+    if constexpr (len == 1) {
+        bytes[0] = static_cast<char>(C);
+    } else {
+        char32_t v = C;
+        for (std::size_t i = len - 1; i > 0; i--) {
+            bytes[i] = static_cast<char>(0x80 | (v & 0x3F));
+            v >>= 6;
+        }
+        // Lead byte: len high bits set, then the remaining payload
+        bytes[0] = static_cast<char>((0xFF00 >> len) | v);
+    }
+    return bytes;
+}
+
+template <char32_t C>
+inline constexpr auto utf8_bytes = utf8_encode<C>();
+
+} // namespace detail
+
+/**
+ * Glyph given as a code point: its UTF-8 bytes are the glyph text
+ */
+template <char32_t C>
+struct utf8_glyph {
+    static constexpr std::string_view text{detail::utf8_bytes<C>.data(),
+                                           detail::utf8_bytes<C>.size()};
+};
+
+struct star {                           // what triangle.c prints
+    static constexpr std::string_view text = "*";
+};
+using full_block = utf8_glyph<U'█'>;   // █
+using black_star = utf8_glyph<U'★'>;   // ★
+
+struct space {                          // what both programs print
+    static constexpr std::string_view text = " ";
+};
+struct no_separator {
+    static constexpr std::string_view text = "";
+};
+
+// Where a number shorter than its cell width sits in the cell
+struct align_right {
+    static constexpr bool right = true;
+};
+struct align_left {
+    static constexpr bool right = false;
+};
+
+/**
+ * Cell width of the concentric square: every policy has
+ * resolve(n), the minimum width for a square of size n
+ */
+struct natural_width {                  // each number its own width
+    static constexpr std::size_t resolve(std::size_t) { return 0; }
+};
+template <std::size_t W>
+struct fixed_width {
+    static constexpr std::size_t resolve(std::size_t) { return W; }
+};
+struct column_width {                   // the width of n: columns align
+    static constexpr std::size_t resolve(std::size_t n) {
+        std::size_t d = 1;
+        for (; n >= 10; n /= 10) {
+            d++;
+        }
+        return d;
+    }
+};
+
+/* ------------------------------------------------------------------ */
+/* Output                                                              */
+/* ------------------------------------------------------------------ */
+
+namespace detail {
+
+template <class A, class B>
+constexpr auto concat() {
+    std::array<char, A::text.size() + B::text.size()> joined{};
+    for (std::size_t i = 0; i < A::text.size(); i++) {
+        joined[i] = A::text[i];
+    }
+    for (std::size_t i = 0; i < B::text.size(); i++) {
+        joined[A::text.size() + i] = B::text[i];
+    }
+    return joined;
+}
+
+/**
+ * Fills dst with count copies of a len-byte token by doubling the
+ * filled prefix, so a row costs O(log count) copies
+ */
+inline void repeat(char *dst, const char *token, std::size_t len,
+                   std::size_t count) {
+    std::size_t total = len * count;
+    if (total == 0) {
+        return;
+    }
+    std::memcpy(dst, token, len);
+    for (std::size_t done = len; done < total;) {
+        std::size_t step = std::min(done, total - done);
+        std::memcpy(dst + done, dst, step);
+        done += step;
+    }
+}
+
+/**
+ * Writes all of iov[0..count) to fd, retrying short writes
+ *
+ * @return 0 on success, otherwise the errno of the failed write
+ */
+inline int writev_all(int fd, struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t done = ::writev(fd, iov, count);
+        if (done < 0 && errno == EINTR) {
+            continue;
+        }
+        if (done < 0) {
+            return errno;
+        }
+        auto left = static_cast<std::size_t>(done);
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+    return 0;
+}
+
+inline int write_chunk(int fd, const char *data, std::size_t len) {
+    struct iovec one = {const_cast<char *>(data), len};
+    return writev_all(fd, &one, 1);
+}
+
+} // namespace detail
+
+/* ------------------------------------------------------------------ */
+/* Triangle                                                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Right triangle of height n: row r is r tokens and a newline
+ */
+template <class Glyph = star, class Separator = space>
+struct triangle_format {
+    static constexpr auto token = detail::concat<Glyph, Separator>();
+    static constexpr std::size_t token_bytes = token.size();
+    static_assert(token_bytes > 0, "glyph and separator are both empty");
+
+    static constexpr std::size_t row_bytes(std::size_t r) {
+        return r * token_bytes + 1;
+    }
+
+    static constexpr unsigned long long total_bytes(unsigned long long n) {
+        return n * (n + 1) / 2 * token_bytes + n;
+    }
+
+    /**
+     * Master row: n tokens and a newline; row r is its last
+     * row_bytes(r) bytes
+     */
+    static std::unique_ptr<char[]> master(std::size_t n) {
+        std::unique_ptr<char[]> row(new char[row_bytes(n)]);
+        detail::repeat(row.get(), token.data(), token_bytes, n);
+        row[row_bytes(n) - 1] = '\n';
+        return row;
+    }
+
+    /**
+     * Writes the triangle to fd as slices of the master row
+     *
+     * @return 0 on success, otherwise the errno of the failed write
+     */
+    static int write(int fd, std::size_t n) {
+        if (n == 0) {
+            return 0;
+        }
+        auto row = master(n);
+        const char *end = row.get() + row_bytes(n);
+        struct iovec iov[PATTERN_FORMAT_IOV];
+        int count = 0;
+        for (std::size_t r = 1; r <= n; r++) {
+            iov[count].iov_base = const_cast<char *>(end - row_bytes(r));
+            iov[count].iov_len = row_bytes(r);
+            if (++count == PATTERN_FORMAT_IOV || r == n) {
+                int err = detail::writev_all(fd, iov, count);
+                if (err != 0) {
+                    return err;
+                }
+                count = 0;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * The whole triangle as one string
+     */
+    static std::string text(std::size_t n) {
+        std::string out;
+        if (n == 0) {
+            return out;
+        }
+        auto row = master(n);
+        const char *end = row.get() + row_bytes(n);
+        out.reserve(total_bytes(n));
+        for (std::size_t r = 1; r <= n; r++) {
+            out.append(end - row_bytes(r), row_bytes(r));
+        }
+        return out;
+    }
+};
+
+/* ------------------------------------------------------------------ */
+/* Concentric square                                                   */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Concentric square for n: 2n-1 rows of 2n-1 cells, each cell a
+ * number padded to the width policy, then the separator
+ */
+template <class Separator = space, class Align = align_right,
+          class Width = natural_width>
+struct concentric_format {
+    static constexpr std::size_t separator_bytes = Separator::text.size();
+
+    static constexpr std::size_t digits(std::size_t v) {
+        return column_width::resolve(v);
+    }
+
+    /**
+     * Bytes of the cell holding v, for a square of size n
+     */
+    static constexpr std::size_t cell_bytes(std::size_t v, std::size_t n) {
+        return std::max(digits(v), Width::resolve(n)) + separator_bytes;
+    }
+
+    static constexpr unsigned long long total_bytes(unsigned long long n) {
+        // Ring v (v >= 2) holds 8(v-1) cells, the center one
+        unsigned long long total = cell_bytes(1, n) + (2 * n - 1);
+        for (unsigned long long v = 2; v <= n; v++) {
+            total += 8 * (v - 1) * cell_bytes(v, n);
+        }
+        return total;
+    }
+
+    /**
+     * Formats the cell for v into dst
+     *
+     * @return Bytes written, cell_bytes(v, n)
+     */
+    static std::size_t format_cell(char *dst, std::size_t v,
+                                   std::size_t n) {
+        std::size_t d = digits(v);
+        std::size_t width = std::max(d, Width::resolve(n));
+        char *num = Align::right ? dst + width - d : dst;
+        std::memset(dst, ' ', width);
+        for (std::size_t k = d; k > 0; k--) {
+            num[k - 1] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        }
+        std::memcpy(dst + width, Separator::text.data(), separator_bytes);
+        return width + separator_bytes;
+    }
+
+    /**
+     * The descending ladder (cells n..1), the ascending one (1..n), and
+     * where each value's cell starts in them
+     */
+    struct ladders {
+        std::size_t n;
+        std::unique_ptr<char[]> desc;
+        std::unique_ptr<char[]> asc;
+        std::unique_ptr<std::size_t[]> desc_at;     // [1..n]
+        std::unique_ptr<std::size_t[]> asc_at;      // [1..n+1]
+        std::size_t row_max;                        // longest row
+
+        explicit ladders(std::size_t size)
+            : n(size), desc_at(new std::size_t[size + 1]),
+              asc_at(new std::size_t[size + 2]) {
+            std::size_t bytes = 0;
+            for (std::size_t v = 1; v <= n; v++) {
+                asc_at[v] = bytes;
+                bytes += cell_bytes(v, n);
+            }
+            asc_at[n + 1] = bytes;
+            desc.reset(new char[bytes]);
+            asc.reset(new char[bytes]);
+            std::size_t at = 0;
+            for (std::size_t v = n; v >= 1; v--) {
+                desc_at[v] = at;
+                at += format_cell(desc.get() + at, v, n);
+            }
+            for (std::size_t v = 1; v <= n; v++) {
+                format_cell(asc.get() + asc_at[v], v, n);
+            }
+            row_max = 0;
+            for (std::size_t p = 1; p <= n; p++) {
+                row_max = std::max(row_max, row_bytes(p));
+            }
+        }
+
+        /**
+         * Bytes of the row whose plateau is p: the cells n..p+1, p
+         * repeated 2p-1 times, p+1..n, and a newline
+         */
+        std::size_t row_bytes(std::size_t p) const {
+            return 2 * (asc_at[n + 1] - asc_at[p + 1]) +
+                   (2 * p - 1) * cell_bytes(p, n) + 1;
+        }
+
+        /**
+         * Assembles the row whose plateau is p into dst
+         *
+         * @return Bytes written, row_bytes(p)
+         */
+        std::size_t row(char *dst, std::size_t p) const {
+            std::size_t outer = asc_at[n + 1] - asc_at[p + 1];
+            std::size_t cell = cell_bytes(p, n);
+            std::memcpy(dst, desc.get(), outer);
+            detail::repeat(dst + outer, desc.get() + desc_at[p], cell,
+                           2 * p - 1);
+            char *tail = dst + outer + (2 * p - 1) * cell;
+            std::memcpy(tail, asc.get() + asc_at[p + 1], outer);
+            tail[outer] = '\n';
+            return row_bytes(p);
+        }
+    };
+
+    /**
+     * Plateau of row k (0-based): the distance to the middle row, plus 1
+     */
+    static constexpr std::size_t plateau(std::size_t n, std::size_t k) {
+        return (k < n - 1 ? n - 1 - k : k - (n - 1)) + 1;
+    }
+
+    /**
+     * Writes the square to fd, rows assembled PATTERN_FORMAT_CHUNK
+     * bytes at a time
+     *
+     * @return 0 on success, otherwise the errno of the failed write
+     */
+    static int write(int fd, std::size_t n) {
+        if (n == 0) {
+            return 0;
+        }
+        ladders lad(n);
+        std::size_t cap = lad.row_max + PATTERN_FORMAT_CHUNK;
+        std::unique_ptr<char[]> buf(new char[cap]);
+        std::size_t used = 0;
+        for (std::size_t k = 0; k < 2 * n - 1; k++) {
+            used += lad.row(buf.get() + used, plateau(n, k));
+            if (used >= PATTERN_FORMAT_CHUNK || k == 2 * n - 2) {
+                int err = detail::write_chunk(fd, buf.get(), used);
+                if (err != 0) {
+                    return err;
+                }
+                used = 0;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * The whole square as one string
+     */
+    static std::string text(std::size_t n) {
+        std::string out;
+        if (n == 0) {
+            return out;
+        }
+        ladders lad(n);
+        out.resize(total_bytes(n));
+        std::size_t at = 0;
+        for (std::size_t k = 0; k < 2 * n - 1; k++) {
+            at += lad.row(&out[at], plateau(n, k));
+        }
+        return out;
+    }
+};
+
+// Token lengths are constants, including multibyte glyphs
+static_assert(triangle_format<>::token_bytes == 2);
+static_assert(triangle_format<full_block, no_separator>::token_bytes == 3);
+static_assert(triangle_format<utf8_glyph<U'\U0001F7E6'>>::token_bytes == 5);
+static_assert(black_star::text == "\xE2\x98\x85");
+static_assert(utf8_glyph<U'é'>::text == "\xC3\xA9");
+// The programs' sizes with the default policies
+static_assert(triangle_format<>::total_bytes(3) == 15);
+static_assert(concentric_format<>::total_bytes(10) == 813);
+static_assert(concentric_format<space, align_right,
+                                column_width>::total_bytes(10) ==
+              19 * 19 * 3 + 19);
+
+} // namespace pattern
+
+#endif // PATTERN_FORMAT_HPP
@@ -0,0 +1,308 @@
+/**
+ * pattern_image.h
+ *
+ * Concentric squares as images: binary PGM (grayscale) or PPM (color).
+ *
+ * Cell (i, j) becomes one pixel whose intensity follows its value: the
+ * center (1) is white and the outer ring (n) black,
+ *
+ *   gray(v) = (n - v) * 255 / (n - 1)
+ *
+ * and PPM maps that gray level through a 256-entry palette, a ramp from
+ * dark blue over teal and green to yellow. At n = 50,000 the image is
+ * 99,999 pixels square, 10 GB as PGM and 30 GB as PPM: far past what
+ * the text output lets anyone look at.
+ *
+ * Pixels are not computed one by one. Row i of the square is the left
+ * run n, n-1 .. p+1, the plateau p repeated 2p-1 times and the right run
+ * p+1 .. n (see pattern_concentric.h), so two ladders of pixels, one per
+ * run direction, are built once per image and every row is two slices of
+ * them around a fill of the plateau pixel.
+ *
+ * The image is cut into tiles of PATTERN_TILE_ROWS rows by
+ * PATTERN_TILE_BYTES bytes, 256 KB, which the pool workers claim in
+ * order and write straight to their final offsets, in the output file's
+ * pages through a shared mapping (pattern_file_map) or in a buffer that
+ * is written out afterwards. A tile's ladder slices and destination rows
+ * fit in L2 together, however wide the image is, and tiles are small
+ * enough that workers finish within a few tiles of each other.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_IMAGE_H
+#define PATTERN_IMAGE_H
+
+#include "pattern_render.h"
+
+// Image formats
+#define PATTERN_IMAGE_PGM 0     // P5, one gray byte per pixel
+#define PATTERN_IMAGE_PPM 1     // P6, three bytes (RGB) per pixel
+
+// Tile size: rows, and bytes of each row
+#define PATTERN_TILE_ROWS  16
+#define PATTERN_TILE_BYTES (16u << 10)
+
+// Longest header pattern_image_header() writes
+#define PATTERN_IMAGE_HEADER_MAX 64
+
+/**
+ * Ladders of one image
+ */
+typedef struct pattern_image {
+    int kind;                   // PATTERN_IMAGE_*
+    size_t n;
+    size_t bpp;                 // bytes per pixel
+    char *down;                 // pixel j: value n - j, for j < n
+    char *up;                   // pixel j: value j + 1, for j < n
+    size_t size;                // bytes mapped for both
+} pattern_image;
+
+/**
+ * Gray level of value v in a square of size n
+ */
+static inline unsigned pattern_image_gray(size_t n, size_t v) {
+    if (n < 2) {
+        return 255;
+    }
+    return (unsigned)((unsigned long long)(n - v) * 255 / (n - 1));
+}
+
+/**
+ * Palette color of a gray level: linear between five anchors
+ */
+static inline void pattern_image_color(unsigned gray, char *rgb) {
+    static const unsigned char anchor[5][3] = {
+        {68, 1, 84},
+        {59, 82, 139},
+        {33, 145, 140},
+        {94, 201, 98},
+        {253, 231, 37},
+    };
+    unsigned seg = gray * 4 / 256;
+    unsigned at = gray * 4 - seg * 256;     // 0..255 within the segment
+    for (int c = 0; c < 3; c++) {
+        int from = anchor[seg][c];
+        int to = anchor[seg + 1][c];
+        rgb[c] = (char)(from + (to - from) * (int)at / 255);
+    }
+}
+
+/**
+ * Writes the pixel of value v
+ */
+static inline void pattern_image_pixel(const pattern_image *img, size_t v,
+                                       char *dst) {
+    unsigned gray = pattern_image_gray(img->n, v);
+    if (img->kind == PATTERN_IMAGE_PGM) {
+        dst[0] = (char)gray;
+    } else {
+        pattern_image_color(gray, dst);
+    }
+}
+
+/**
+ * Bytes of pixel data, without the header
+ */
+static inline unsigned long long pattern_image_bytes(int kind, size_t n) {
+    unsigned long long side = 2 * (unsigned long long)n - 1;
+    return side * side * (kind == PATTERN_IMAGE_PGM ? 1 : 3);
+}
+
+/**
+ * Writes the PGM or PPM header ("P5\n<w> <h>\n255\n")
+ *
+ * @param dst PATTERN_IMAGE_HEADER_MAX bytes
+ * @return Header length
+ */
+static inline size_t pattern_image_header(char *dst, int kind, size_t n) {
+    size_t side = 2 * n - 1;
+    return (size_t)snprintf(dst, PATTERN_IMAGE_HEADER_MAX,
+                            "P%c\n%zu %zu\n255\n",
+                            kind == PATTERN_IMAGE_PGM ? '5' : '6', side,
+                            side);
+}
+
+/**
+ * Builds the pixel ladders of an image
+ *
+ * @return 0 on success, -1 if memory could not be mapped
+ */
+static inline int pattern_image_init(pattern_image *img, int kind,
+                                     size_t n) {
+    img->kind = kind;
+    img->n = n;
+    img->bpp = kind == PATTERN_IMAGE_PGM ? 1 : 3;
+    img->size = pattern_page_round(2 * n * img->bpp);
+    img->down = pattern_map(img->size);
+    if (img->down == NULL) {
+        return -1;
+    }
+    img->up = img->down + n * img->bpp;
+    for (size_t j = 0; j < n; j++) {
+        pattern_image_pixel(img, n - j, img->down + j * img->bpp);
+        pattern_image_pixel(img, j + 1, img->up + j * img->bpp);
+    }
+    return 0;
+}
+
+static inline void pattern_image_free(pattern_image *img) {
+    pattern_unmap(img->down, img->size);
+    img->down = NULL;
+    img->up = NULL;
+}
+
+/**
+ * Writes columns [from, to) of row i
+ */
+static inline void pattern_image_span(const pattern_image *img, char *dst,
+                                      size_t i, size_t from, size_t to) {
+    size_t n = img->n;
+    size_t bpp = img->bpp;
+    size_t p = concentric_row_plateau(n, i);
+    size_t left = n - p;                // columns of the left run
+    size_t right = n + p - 1;           // first column of the right run
+
+    if (from < left) {
+        size_t end = to < left ? to : left;
+        memcpy(dst, img->down + from * bpp, (end - from) * bpp);
+        dst += (end - from) * bpp;
+        from = end;
+    }
+    if (from < to && from < right) {
+        size_t end = to < right ? to : right;
+        pattern_fill(dst, img->down + (n - p) * bpp, bpp,
+                     (end - from) * bpp);
+        dst += (end - from) * bpp;
+        from = end;
+    }
+    if (from < to) {
+        memcpy(dst, img->up + (from - n + 1) * bpp, (to - from) * bpp);
+    }
+}
+
+/**
+ * One tiled render: workers claim tiles by index, row-major
+ */
+typedef struct pattern_image_job {
+    const pattern_image *img;
+    char *dst;
+    size_t side;
+    size_t tile_cols;           // pixels per tile row
+    size_t across;              // tiles per image row
+    size_t tiles;
+    size_t next;                // next unclaimed tile (atomic)
+} pattern_image_job;
+
+static inline void pattern_image_run(void *arg, int worker) {
+    pattern_image_job *job = arg;
+    size_t stride = job->side * job->img->bpp;
+    size_t t;
+    (void)worker;
+    while ((t = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) <
+           job->tiles) {
+        size_t row = t / job->across * PATTERN_TILE_ROWS;
+        size_t col = t % job->across * job->tile_cols;
+        size_t rows = job->side - row < PATTERN_TILE_ROWS
+                          ? job->side - row
+                          : PATTERN_TILE_ROWS;
+        size_t cols = job->side - col < job->tile_cols ? job->side - col
+                                                       : job->tile_cols;
+        for (size_t i = row; i < row + rows; i++) {
+            pattern_image_span(job->img,
+                               job->dst + i * stride + col * job->img->bpp,
+                               i, col, col + cols);
+        }
+    }
+}
+
+/**
+ * Writes all pixels of an image on every pool worker, tile by tile
+ *
+ * @param dst pattern_image_bytes() bytes
+ */
+static inline void pattern_image_tiles(pattern_ctx *ctx,
+                                       const pattern_image *img,
+                                       char *dst) {
+    pattern_image_job job;
+    job.img = img;
+    job.dst = dst;
+    job.side = 2 * img->n - 1;
+    job.tile_cols = PATTERN_TILE_BYTES / img->bpp;
+    job.across = (job.side + job.tile_cols - 1) / job.tile_cols;
+    job.tiles = (job.side + PATTERN_TILE_ROWS - 1) / PATTERN_TILE_ROWS *
+                job.across;
+    job.next = 0;
+    ctx->spread = 0;
+    if (ctx->pool.count < 2 ||
+        pattern_image_bytes(img->kind, img->n) < ctx->parallel_min) {
+        pattern_image_run(&job, 0);
+        return;
+    }
+    pattern_pool_run(&ctx->pool, pattern_image_run, &job);
+}
+
+/**
+ * Renders the image of n into the output
+ *
+ * With `file`, the image goes straight into the output file's pages
+ * (pattern_file_map); otherwise it is built in a buffer from
+ * pattern_map_buffer() and written out, which also works on pipes.
+ * ctx->pages and ctx->populate apply as for the text sinks, except that
+ * prefaulting is done up front rather than by each worker: tiles are
+ * claimed dynamically, so no worker owns a fixed part of the image.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_image_write(pattern_ctx *ctx, int kind,
+                                      size_t n, int file) {
+    char header[PATTERN_IMAGE_HEADER_MAX];
+    size_t head = pattern_image_header(header, kind, n);
+    size_t bytes = head + (size_t)pattern_image_bytes(kind, n);
+    pattern_image img;
+    if (pattern_ctx_flush(ctx) != 0) {
+        return -1;
+    }
+    if (pattern_image_init(&img, kind, n) != 0) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+
+    int status;
+    if (file) {
+        pattern_file_span span;
+        char *dst = pattern_file_map(ctx, bytes, &span);
+        status = dst == NULL ? -1 : 0;
+        if (dst != NULL) {
+            if (ctx->populate) {
+                pattern_populate(dst, bytes);
+            }
+            memcpy(dst, header, head);
+            pattern_image_tiles(ctx, &img, dst + head);
+            status = pattern_file_unmap(ctx, &span);
+        }
+    } else {
+        size_t size = bytes;
+        ctx->pages_used = ctx->pages;
+        char *buf = pattern_map_buffer(&size, &ctx->pages_used,
+                                       ctx->populate);
+        if (buf == NULL) {
+            ctx->out.error = ENOMEM;
+            status = -1;
+        } else {
+            memcpy(buf, header, head);
+            pattern_image_tiles(ctx, &img, buf + head);
+            status = pattern_writer_ref(&ctx->out, buf, bytes) == 0 &&
+                             pattern_writer_flush(&ctx->out) == 0
+                         ? 0
+                         : -1;
+            pattern_unmap(buf, size);
+        }
+    }
+    pattern_image_free(&img);
+    return status;
+}
+
+#endif // PATTERN_IMAGE_H
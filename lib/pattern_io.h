@@ -0,0 +1,543 @@
+/**
+ * pattern_io.h
+ *
+ * Output layer shared by the pattern programs.
+ *
+ * The renderers describe their output as a sequence of byte ranges:
+ * either references to long-lived buffers (the triangle master row,
+ * the concentric number ladders) or short pieces staged in a page-backed
+ * arena. The writer batches those ranges into iovecs and hands them to
+ * the kernel with writev(2), or, when asked to and the output is a pipe,
+ * with vmsplice(2), so already-formatted pages reach the consumer
+ * without a copy.
+ *
+ * Page lifetime rules for vmsplice:
+ * vmsplice without SPLICE_F_GIFT makes the pipe point at our pages
+ * instead of copying them. Until the consumer has read them, any store
+ * into those pages would change what the consumer sees. So:
+ *   - referenced buffers are never written again once queued; masters
+ *     are rebuilt into fresh mappings, never in place
+ *   - the staging arena is retired after every splice: it is unmapped
+ *     and a fresh one is mapped. munmap() only drops our mapping, the
+ *     pipe keeps its own page references, so the data stays valid.
+ *
+ * Programs including this header must define _GNU_SOURCE before their
+ * first #include (vmsplice and F_SETPIPE_SZ are GNU extensions).
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_IO_H
+#define PATTERN_IO_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pattern_simd.h"
+
+// Output sinks understood by the writer
+#define PATTERN_SINK_AUTO   0   // writev; see pattern_writer_init()
+#define PATTERN_SINK_WRITEV 1
+#define PATTERN_SINK_SPLICE 2
+
+// Exit status when the consumer closed the pipe before the pattern was
+// complete (1 is already used for bad input)
+#define PATTERN_EXIT_CLOSED 3
+
+// iovecs gathered before a syscall (well under IOV_MAX = 1024)
+#define PATTERN_IOV_BATCH 512
+
+// Staging arena size; grows on demand for single oversized pieces
+#define PATTERN_ARENA_SIZE (1u << 20)
+
+// References shorter than this are copied into the arena instead.
+// Every vmsplice'd iovec occupies a whole pipe slot, so tiny references
+// would fill the pipe long before its byte capacity; for writev they
+// would just waste iovecs.
+#define PATTERN_SPLICE_REF_MIN 4096
+#define PATTERN_WRITEV_REF_MIN 256
+
+// Pipe capacity requested in splice mode (the unprivileged default max)
+#define PATTERN_PIPE_SIZE (1 << 20)
+
+/**
+ * Batched writer over a file descriptor
+ *
+ * Ranges queued with pattern_writer_ref() must stay valid and unmodified
+ * until the writer is flushed, and in splice mode until the consumer has
+ * read them (i.e. for the rest of the process, or until unmapped).
+ */
+typedef struct pattern_writer {
+    int fd;
+    int sink;                   // resolved sink: WRITEV or SPLICE
+    int error;                  // first errno seen, sticky
+    size_t ref_min;             // shorter references get copied
+    struct iovec iov[PATTERN_IOV_BATCH];
+    int iovcnt;
+    char *arena;                // page-backed staging area
+    size_t arena_size;
+    size_t arena_used;
+    unsigned long long bytes;   // bytes handed to the kernel so far
+    int timed;                  // clock every syscall (--stats)
+    unsigned long long syscalls;    // writev/vmsplice calls made
+    unsigned long long syscall_ns;  // time spent in them, when timed
+} pattern_writer;
+
+/**
+ * Maps zero-filled anonymous memory (page aligned, never recycled by
+ * malloc, which is what the vmsplice lifetime rules need)
+ *
+ * @return Mapping, or NULL on failure
+ */
+static inline void *pattern_map(size_t size) {
+    void *p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+static inline void pattern_unmap(void *p, size_t size) {
+    if (p != NULL) {
+        munmap(p, size);
+    }
+}
+
+/**
+ * Rounds a byte count up to whole pages
+ */
+static inline size_t pattern_page_round(size_t size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (size + page - 1) / page * page;
+}
+
+// Page size policy for large output buffers
+#define PATTERN_PAGES_SMALL   0     // base pages
+#define PATTERN_PAGES_THP     1     // transparent huge pages (madvise)
+#define PATTERN_PAGES_HUGETLB 2     // reserved huge pages, else THP
+
+static const char *const pattern_pages_names[] = {
+    "off",
+    "thp",
+    "hugetlb",
+};
+
+#define PATTERN_PAGE_POLICIES 3
+
+/**
+ * @return PATTERN_PAGES_* for a name in pattern_pages_names, or -1
+ */
+static inline int pattern_pages_parse(const char *name) {
+    for (int pages = 0; pages < PATTERN_PAGE_POLICIES; pages++) {
+        if (strcmp(name, pattern_pages_names[pages]) == 0) {
+            return pages;
+        }
+    }
+    return -1;
+}
+
+#define PATTERN_HUGE_PAGE ((size_t)2 << 20)
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+/**
+ * Faults a mapping in for writing before it is used
+ *
+ * MADV_POPULATE_WRITE (Linux 5.14) does it in one call and respects
+ * MADV_HUGEPAGE; older kernels get one store per base page.
+ */
+static inline void pattern_populate(char *p, size_t size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t skew = (size_t)((uintptr_t)p & (page - 1));
+    if (madvise(p - skew, size + skew, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+    for (size_t at = 0; at < size; at += page) {
+        ((volatile char *)p)[at] = p[at];
+    }
+}
+
+/**
+ * Maps a large output buffer
+ *
+ * With 4 KB pages, every page of a multi-gigabyte render costs a page
+ * fault and a TLB entry. PATTERN_PAGES_HUGETLB takes 2 MB pages from
+ * the reserved pool (vm.nr_hugepages) and falls back to transparent
+ * huge pages when the pool is empty; PATTERN_PAGES_THP aligns the
+ * mapping to 2 MB and asks for them with MADV_HUGEPAGE, which needs
+ * THP set to "madvise" or "always". Prefaulting is separate: with
+ * `populate`, all faults are taken here instead of during the render.
+ *
+ * @param size  Bytes wanted; on return, the size to pass to munmap
+ * @param pages PATTERN_PAGES_*; on return, the policy actually applied
+ * @return Mapping, or NULL on failure
+ */
+static inline char *pattern_map_buffer(size_t *size, int *pages,
+                                       int populate) {
+    if (*pages == PATTERN_PAGES_HUGETLB) {
+        size_t huge = (*size + PATTERN_HUGE_PAGE - 1) / PATTERN_HUGE_PAGE *
+                      PATTERN_HUGE_PAGE;
+        void *p = mmap(NULL, huge, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                           (populate ? MAP_POPULATE : 0),
+                       -1, 0);
+        if (p != MAP_FAILED) {
+            *size = huge;
+            return p;
+        }
+        *pages = PATTERN_PAGES_THP;
+    }
+
+    if (*pages != PATTERN_PAGES_THP) {
+        *size = pattern_page_round(*size);
+        void *p = mmap(NULL, *size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS |
+                           (populate ? MAP_POPULATE : 0),
+                       -1, 0);
+        return p == MAP_FAILED ? NULL : p;
+    }
+
+    // Huge pages only back 2 MB-aligned ranges: over-map and trim
+    size_t huge = (*size + PATTERN_HUGE_PAGE - 1) / PATTERN_HUGE_PAGE *
+                  PATTERN_HUGE_PAGE;
+    char *p = pattern_map(huge + PATTERN_HUGE_PAGE);
+    if (p == NULL) {
+        return NULL;
+    }
+    size_t head = -(size_t)(uintptr_t)p % PATTERN_HUGE_PAGE;
+    if (head > 0) {
+        munmap(p, head);
+    }
+    munmap(p + head + huge, PATTERN_HUGE_PAGE - head);
+    p += head;
+    madvise(p, huge, MADV_HUGEPAGE);
+    if (populate) {
+        pattern_populate(p, huge);
+    }
+    *size = huge;
+    return p;
+}
+
+/**
+ * Fills dst[0, len) with a token repeated, with the kernel variant for
+ * this CPU (see pattern_simd.h); `token` may be dst itself
+ */
+static inline void pattern_fill(char *dst, const char *token,
+                                size_t token_len, size_t len) {
+    pattern_fill_variants[pattern_isa()](dst, token, token_len, len);
+}
+
+// Bytes of a streamed fill written with normal stores, then copied on
+#define PATTERN_STREAM_HEAD (16u << 10)
+
+/**
+ * Copies len bytes, with non-temporal stores when `stream` is set
+ * (see pattern_copy_stream_scalar)
+ */
+static inline void pattern_copy(char *dst, const char *src, size_t len,
+                                int stream) {
+    if (stream) {
+        pattern_copy_stream_variants[pattern_isa()](dst, src, len);
+    } else {
+        memcpy(dst, src, len);
+    }
+}
+
+/**
+ * pattern_fill(), with non-temporal stores when `stream` is set
+ *
+ * A streamed fill lays down PATTERN_STREAM_HEAD bytes of whole tokens
+ * with normal stores and copies that head over the rest, so the source
+ * of every streaming copy stays in cache.
+ */
+static inline void pattern_fill_mode(char *dst, const char *token,
+                                     size_t token_len, size_t len,
+                                     int stream) {
+    size_t head = PATTERN_STREAM_HEAD - PATTERN_STREAM_HEAD % token_len;
+    if (!stream || len <= 2 * head) {
+        pattern_fill(dst, token, token_len, len);
+        return;
+    }
+    pattern_fill(dst, token, token_len, head);
+    for (size_t at = head; at < len; at += head) {
+        pattern_copy(dst + at, dst, head < len - at ? head : len - at, 1);
+    }
+}
+
+/**
+ * Monotonic clock in nanoseconds
+ */
+static inline unsigned long long pattern_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * Checks whether a file descriptor refers to a pipe (or FIFO)
+ */
+static inline int pattern_fd_is_pipe(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+}
+
+/**
+ * Turns SIGPIPE into EPIPE write errors
+ *
+ * With the default action, a write to a pipe without a reader kills the
+ * process. Job runners often start children with SIGPIPE ignored,
+ * though, and then every printf on the dead pipe just fails while the
+ * O(n²) loop carries on to the end. Ignoring it explicitly gives one
+ * predictable behavior: the failed write reports EPIPE, the renderer
+ * stops within the current chunk and the program exits with
+ * PATTERN_EXIT_CLOSED.
+ */
+static inline void pattern_ignore_sigpipe(void) {
+    signal(SIGPIPE, SIG_IGN);
+}
+
+/**
+ * Exit status for a failed output stream
+ *
+ * @param err errno of the failed write
+ */
+static inline int pattern_output_status(int err) {
+    return err == EPIPE ? PATTERN_EXIT_CLOSED : 1;
+}
+
+/**
+ * Sets up a writer on a file descriptor
+ *
+ * PATTERN_SINK_AUTO resolves to writev. Splice is only used when asked
+ * for: it wins on single large triangles, but the per-splice arena swap
+ * makes it slower for batches of patterns and for concentric rows, whose
+ * middle runs are staged. Asking for splice on a non-pipe falls back to
+ * writev, so callers never have to check the descriptor type themselves.
+ *
+ * @return 0 on success, -1 if the staging arena could not be mapped
+ */
+static inline int pattern_writer_init(pattern_writer *w, int fd, int sink) {
+    memset(w, 0, sizeof(*w));
+    w->fd = fd;
+
+    int is_pipe = pattern_fd_is_pipe(fd);
+    w->sink = (sink == PATTERN_SINK_SPLICE && is_pipe) ? PATTERN_SINK_SPLICE
+                                                     : PATTERN_SINK_WRITEV;
+    w->ref_min = w->sink == PATTERN_SINK_SPLICE ? PATTERN_SPLICE_REF_MIN
+                                                : PATTERN_WRITEV_REF_MIN;
+
+    if (w->sink == PATTERN_SINK_SPLICE) {
+        // More pipe slots means fewer wakeups per spliced page.
+        // Failure (e.g. over /proc/sys/fs/pipe-max-size) is harmless.
+        fcntl(fd, F_SETPIPE_SZ, PATTERN_PIPE_SIZE);
+    }
+
+    w->arena_size = PATTERN_ARENA_SIZE;
+    w->arena = pattern_map(w->arena_size);
+    if (w->arena == NULL) {
+        w->error = ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Drops the first `done` bytes from an iovec array in place
+ *
+ * @return Number of iovecs still pending
+ */
+static inline int pattern_iov_advance(struct iovec **iov, int cnt,
+                                      size_t done) {
+    while (cnt > 0 && done >= (*iov)->iov_len) {
+        done -= (*iov)->iov_len;
+        (*iov)++;
+        cnt--;
+    }
+    if (cnt > 0) {
+        (*iov)->iov_base = (char *)(*iov)->iov_base + done;
+        (*iov)->iov_len -= done;
+    }
+    return cnt;
+}
+
+/**
+ * Hands every queued range to the kernel
+ *
+ * In splice mode the arena is swapped for a fresh mapping afterwards
+ * (see the lifetime rules at the top of this file); in writev mode the
+ * kernel has copied the bytes and the arena is simply reused.
+ *
+ * @return 0 on success, -1 on error (errno kept in w->error)
+ */
+static inline int pattern_writer_flush(pattern_writer *w) {
+    struct iovec *iov = w->iov;
+    int cnt = w->iovcnt;
+    int spliced = 0;
+
+    while (cnt > 0 && w->error == 0) {
+        unsigned long long start = w->timed ? pattern_now_ns() : 0;
+        ssize_t done;
+        w->syscalls++;
+        if (w->sink == PATTERN_SINK_SPLICE) {
+            done = vmsplice(w->fd, iov, (unsigned long)cnt, 0);
+            if (done < 0 && (errno == EINVAL || errno == ENOSYS) &&
+                !spliced) {
+                // Kernel or descriptor refuses vmsplice: degrade quietly
+                w->sink = PATTERN_SINK_WRITEV;
+                w->ref_min = PATTERN_WRITEV_REF_MIN;
+                continue;
+            }
+            spliced |= done > 0;
+        } else {
+            done = writev(w->fd, iov, cnt);
+        }
+        if (w->timed) {
+            w->syscall_ns += pattern_now_ns() - start;
+        }
+
+        if (done < 0) {
+            if (errno != EINTR) {
+                w->error = errno;
+            }
+            continue;
+        }
+        w->bytes += (unsigned long long)done;
+        cnt = pattern_iov_advance(&iov, cnt, (size_t)done);
+    }
+    w->iovcnt = 0;
+
+    if (spliced && w->arena_used > 0) {
+        // The pipe may still reference arena pages: never reuse them
+        pattern_unmap(w->arena, w->arena_size);
+        w->arena_size = PATTERN_ARENA_SIZE;
+        w->arena = pattern_map(w->arena_size);
+        if (w->arena == NULL && w->error == 0) {
+            w->error = ENOMEM;
+        }
+    }
+    w->arena_used = 0;
+
+    return w->error ? -1 : 0;
+}
+
+/**
+ * Appends a range to the iovec batch, merging it with the previous one
+ * when the two are contiguous in memory
+ */
+static inline int pattern_writer_queue(pattern_writer *w, const char *p,
+                                       size_t len) {
+    if (w->iovcnt > 0) {
+        struct iovec *last = &w->iov[w->iovcnt - 1];
+        if ((const char *)last->iov_base + last->iov_len == p) {
+            last->iov_len += len;
+            return 0;
+        }
+    }
+    w->iov[w->iovcnt].iov_base = (void *)p;
+    w->iov[w->iovcnt].iov_len = len;
+    w->iovcnt++;
+
+    // Flush as soon as the batch is full, so there is always a free slot
+    // and arena pieces are queued before the arena can be retired
+    if (w->iovcnt == PATTERN_IOV_BATCH) {
+        return pattern_writer_flush(w);
+    }
+    return 0;
+}
+
+/**
+ * Returns space for `len` bytes in the staging arena
+ *
+ * The caller fills the space and then calls pattern_writer_commit()
+ * with the same length. Oversized requests get a dedicated, larger
+ * arena mapping.
+ *
+ * @return Pointer to fill, or NULL on error
+ */
+static inline char *pattern_writer_reserve(pattern_writer *w, size_t len) {
+    if (w->error) {
+        return NULL;
+    }
+    if (w->arena_size - w->arena_used < len) {
+        if (pattern_writer_flush(w) != 0) {
+            return NULL;
+        }
+        if (len > w->arena_size) {
+            pattern_unmap(w->arena, w->arena_size);
+            w->arena_size = pattern_page_round(len);
+            w->arena = pattern_map(w->arena_size);
+            if (w->arena == NULL) {
+                w->error = ENOMEM;
+                return NULL;
+            }
+        }
+    }
+    return w->arena + w->arena_used;
+}
+
+/**
+ * Queues `len` bytes previously filled through pattern_writer_reserve()
+ */
+static inline int pattern_writer_commit(pattern_writer *w, size_t len) {
+    char *p = w->arena + w->arena_used;
+    w->arena_used += len;
+    return pattern_writer_queue(w, p, len);
+}
+
+/**
+ * Queues a copy of a short-lived range
+ */
+static inline int pattern_writer_copy(pattern_writer *w, const char *p,
+                                      size_t len) {
+    char *dst = pattern_writer_reserve(w, len);
+    if (dst == NULL) {
+        return -1;
+    }
+    memcpy(dst, p, len);
+    return pattern_writer_commit(w, len);
+}
+
+/**
+ * Queues a long-lived range by reference (zero-copy)
+ *
+ * Short ranges are copied anyway; see PATTERN_SPLICE_REF_MIN.
+ */
+static inline int pattern_writer_ref(pattern_writer *w, const char *p,
+                                     size_t len) {
+    if (w->error) {
+        return -1;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    if (len < w->ref_min) {
+        return pattern_writer_copy(w, p, len);
+    }
+    return pattern_writer_queue(w, p, len);
+}
+
+/**
+ * Flushes pending output and releases the arena
+ *
+ * @return 0 on success, -1 if any write failed (errno in w->error)
+ */
+static inline int pattern_writer_close(pattern_writer *w) {
+    int status = pattern_writer_flush(w);
+    pattern_unmap(w->arena, w->arena_size);
+    w->arena = NULL;
+    w->arena_size = 0;
+    return status;
+}
+
+#endif // PATTERN_IO_H
@@ -0,0 +1,233 @@
+/**
+ * pattern_ipc.h
+ *
+ * Wire protocol between the render daemon and co-located clients.
+ *
+ * A client connects to the daemon's Unix stream socket and sends fixed
+ * size requests. Each reply carries the rendered pattern as a memfd
+ * passed with SCM_RIGHTS, so no pattern byte crosses the socket: the
+ * client maps the descriptor read-only and reads the daemon's pages
+ * directly. The memfd is sealed against writes and resizing before it is
+ * shared, so one client can never change what another one sees.
+ *
+ *   client                          daemon
+ *     | -- request {shape, n, options} -->|
+ *     |                                   | cache hit, or render once
+ *     |<-- reply {status, size} + memfd --|
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_IPC_H
+#define PATTERN_IPC_H
+
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "pattern_render.h"
+
+#define PATTERN_IPC_MAGIC 0x4e544150u   // "PATN"
+
+// Default socket path
+#define PATTERN_IPC_SOCKET "/tmp/pattern_daemon.sock"
+
+/**
+ * Render request; (shape, n, options) is the cache key
+ *
+ * options is reserved for output variants and must be 0 for now.
+ */
+typedef struct pattern_ipc_request {
+    uint32_t magic;
+    uint32_t shape;
+    uint64_t n;
+    uint32_t options;
+    uint32_t reserved;
+} pattern_ipc_request;
+
+/**
+ * Reply; a memfd accompanies it when status is 0
+ */
+typedef struct pattern_ipc_reply {
+    uint32_t magic;
+    int32_t status;         // 0, or a positive errno
+    uint64_t size;          // bytes of pattern in the memfd
+} pattern_ipc_reply;
+
+/**
+ * Reads or writes exactly `len` bytes on a stream socket
+ *
+ * @return 0 on success, -1 on error or end of stream
+ */
+static inline int pattern_ipc_recv_all(int sock, void *buf, size_t len) {
+    char *at = buf;
+    while (len > 0) {
+        ssize_t got = recv(sock, at, len, 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return -1;
+        }
+        at += got;
+        len -= (size_t)got;
+    }
+    return 0;
+}
+
+static inline int pattern_ipc_send_all(int sock, const void *buf,
+                                       size_t len) {
+    const char *at = buf;
+    while (len > 0) {
+        ssize_t put = send(sock, at, len, MSG_NOSIGNAL);
+        if (put < 0 && errno == EINTR) {
+            continue;
+        }
+        if (put <= 0) {
+            return -1;
+        }
+        at += put;
+        len -= (size_t)put;
+    }
+    return 0;
+}
+
+/**
+ * Sends a reply, attaching `fd` with SCM_RIGHTS when it is not -1
+ *
+ * @return 0 on success, -1 on error
+ */
+static inline int pattern_ipc_send_reply(int sock,
+                                         const pattern_ipc_reply *reply,
+                                         int fd) {
+    struct iovec iov = {.iov_base = (void *)reply, .iov_len = sizeof(*reply)};
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1};
+
+    if (fd >= 0) {
+        memset(&control, 0, sizeof(control));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t put;
+    do {
+        put = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (put < 0 && errno == EINTR);
+    return put == (ssize_t)sizeof(*reply) ? 0 : -1;
+}
+
+/**
+ * Receives a reply and the descriptor attached to it, if any
+ *
+ * @param fd Set to the received descriptor, or -1
+ * @return 0 on success, -1 on error
+ */
+static inline int pattern_ipc_recv_reply(int sock, pattern_ipc_reply *reply,
+                                         int *fd) {
+    struct iovec iov = {.iov_base = reply, .iov_len = sizeof(*reply)};
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buf,
+        .msg_controllen = sizeof(control.buf),
+    };
+
+    *fd = -1;
+    ssize_t got;
+    do {
+        got = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (got < 0 && errno == EINTR);
+    if (got != (ssize_t)sizeof(*reply) || reply->magic != PATTERN_IPC_MAGIC) {
+        return -1;
+    }
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET &&
+        cmsg->cmsg_type == SCM_RIGHTS) {
+        memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return 0;
+}
+
+/**
+ * Connects to the daemon
+ *
+ * @return Socket, or -1 on error
+ */
+static inline int pattern_ipc_connect(const char *path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock >= 0 &&
+        connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(sock);
+        sock = -1;
+    }
+    return sock;
+}
+
+/**
+ * Asks the daemon for a pattern and maps the result read-only
+ *
+ * The returned mapping stays valid after the descriptor is closed and
+ * even after the daemon evicts or exits; release it with munmap().
+ *
+ * @param data Set to the read-only mapping
+ * @param size Set to its length in bytes
+ * @return 0 on success, otherwise an errno value
+ */
+static inline int pattern_ipc_fetch(int sock, int shape, size_t n,
+                                    uint32_t options, const char **data,
+                                    size_t *size) {
+    pattern_ipc_request request = {
+        .magic = PATTERN_IPC_MAGIC,
+        .shape = (uint32_t)shape,
+        .n = n,
+        .options = options,
+    };
+    pattern_ipc_reply reply;
+    int fd;
+
+    if (pattern_ipc_send_all(sock, &request, sizeof(request)) != 0 ||
+        pattern_ipc_recv_reply(sock, &reply, &fd) != 0) {
+        return EPROTO;
+    }
+    if (reply.status != 0 || fd < 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return reply.status != 0 ? reply.status : EPROTO;
+    }
+
+    void *map = mmap(NULL, (size_t)reply.size, PROT_READ, MAP_SHARED, fd, 0);
+    int err = map == MAP_FAILED ? errno : 0;
+    close(fd);
+    if (err != 0) {
+        return err;
+    }
+    *data = map;
+    *size = (size_t)reply.size;
+    return 0;
+}
+
+#endif // PATTERN_IPC_H
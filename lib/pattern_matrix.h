@@ -0,0 +1,230 @@
+/**
+ * pattern_matrix.h
+ *
+ * Binary export of the concentric square's value matrix.
+ *
+ * Instead of "%d " text, the (2n-1) x (2n-1) cell values are written as
+ * one C-order array of little-endian unsigned integers, in the smallest
+ * width that holds the largest value n:
+ *
+ *   n <= 255      1 byte  (NumPy dtype |u1)
+ *   n <= 65535    2 bytes (<u2)
+ *   otherwise     4 bytes (<u4)
+ *
+ * The raw form is the bare array. The .npy form puts a NumPy format 1.0
+ * header in front, padded to 64 bytes as NumPy pads its own, so the
+ * array starts aligned and a consumer loads it with
+ *
+ *   a = np.load("square.npy", mmap_mode="r")
+ *
+ * which maps the file instead of parsing it. Several arrays written back
+ * to back can be read in turn with np.load() on one open file object.
+ *
+ * Rows come from concentric_cell_row(), the vector value kernel, in
+ * blocks of PATTERN_MATRIX_BLOCK cells that are narrowed to the element
+ * width while they are still in L1. Large matrices are split over the
+ * pool one row slice per worker, like pattern_render_spread(), straight
+ * into the output file's pages (pattern_file_map) or into a buffer that
+ * is then written out.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_MATRIX_H
+#define PATTERN_MATRIX_H
+
+#include "pattern_render.h"
+
+// Cells computed at a time, as uint32_t, before narrowing
+#define PATTERN_MATRIX_BLOCK 1024
+
+// .npy headers are padded to a multiple of this (NumPy's ARRAY_ALIGN)
+#define PATTERN_NPY_ALIGN 64
+
+// Longest header pattern_matrix_npy_header() writes
+#define PATTERN_NPY_HEADER_MAX 128
+
+/**
+ * Bytes per element for a square of size n
+ */
+static inline size_t pattern_matrix_width(size_t n) {
+    return n <= UINT8_MAX ? 1 : n <= UINT16_MAX ? 2 : 4;
+}
+
+/**
+ * Bytes in the value matrix, without a header
+ */
+static inline unsigned long long pattern_matrix_bytes(size_t n) {
+    unsigned long long side = 2 * (unsigned long long)n - 1;
+    return side * side * pattern_matrix_width(n);
+}
+
+/**
+ * Writes the .npy header for the value matrix of n
+ *
+ * Magic, version 1.0, the little-endian header length, then the array
+ * description as a Python dict literal, space-padded and ended with a
+ * newline so that the array starts at a multiple of PATTERN_NPY_ALIGN.
+ *
+ * @param dst PATTERN_NPY_HEADER_MAX bytes
+ * @return Header length
+ */
+static inline size_t pattern_matrix_npy_header(char *dst, size_t n) {
+    static const char *const descr[] = {"|u1", "<u2", NULL, "<u4"};
+    size_t side = 2 * n - 1;
+    char dict[PATTERN_NPY_HEADER_MAX];
+    int len = snprintf(dict, sizeof(dict),
+                       "{'descr': '%s', 'fortran_order': False, "
+                       "'shape': (%zu, %zu), }",
+                       descr[pattern_matrix_width(n) - 1], side, side);
+    size_t total = (10 + (size_t)len + 1 + PATTERN_NPY_ALIGN - 1) /
+                   PATTERN_NPY_ALIGN * PATTERN_NPY_ALIGN;
+
+    memcpy(dst, "\x93NUMPY\x01\x00", 8);
+    dst[8] = (char)((total - 10) & 0xff);
+    dst[9] = (char)((total - 10) >> 8);
+    memcpy(dst + 10, dict, (size_t)len);
+    memset(dst + 10 + len, ' ', total - 11 - (size_t)len);
+    dst[total - 1] = '\n';
+    return total;
+}
+
+/**
+ * Stores `count` values as little-endian integers of `width` bytes, with
+ * the narrowing kernel for this CPU (see pattern_simd.h)
+ */
+static inline void pattern_matrix_narrow(char *dst, uint32_t *cells,
+                                         size_t count, size_t width) {
+    if (width < 4) {
+        pattern_narrow_variants[pattern_isa()](dst, cells, count, width);
+        return;
+    }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t j = 0; j < count; j++) {
+        cells[j] = __builtin_bswap32(cells[j]);
+    }
+#endif
+    memcpy(dst, cells, count * 4);
+}
+
+/**
+ * Writes rows [first, last) of the value matrix of n
+ */
+static inline void pattern_matrix_rows(char *dst, size_t n, size_t first,
+                                       size_t last) {
+    size_t width = pattern_matrix_width(n);
+    size_t side = 2 * n - 1;
+    uint32_t cells[PATTERN_MATRIX_BLOCK];
+    for (size_t i = first; i < last; i++) {
+        for (size_t j = 0; j < side; j += PATTERN_MATRIX_BLOCK) {
+            size_t count = side - j < PATTERN_MATRIX_BLOCK
+                               ? side - j
+                               : PATTERN_MATRIX_BLOCK;
+            concentric_cell_row(cells, n, i, j, count);
+            pattern_matrix_narrow(dst, cells, count, width);
+            dst += count * width;
+        }
+    }
+}
+
+/**
+ * One spread export: worker t writes an equal share of the rows
+ */
+typedef struct pattern_matrix_job {
+    pattern_ctx *ctx;
+    size_t n;
+    char *dst;
+    int populate;
+} pattern_matrix_job;
+
+static inline void pattern_matrix_run(void *arg, int worker) {
+    pattern_matrix_job *job = arg;
+    unsigned long long start = pattern_now_ns();
+    size_t workers = (size_t)job->ctx->pool.count;
+    size_t side = 2 * job->n - 1;
+    size_t row = side * pattern_matrix_width(job->n);
+    size_t first = side * (size_t)worker / workers;
+    size_t last = side * (size_t)(worker + 1) / workers;
+    char *slice = job->dst + first * row;
+
+    if (job->populate) {
+        pattern_slice_populate(slice, (last - first) * row);
+    }
+    pattern_matrix_rows(slice, job->n, first, last);
+    pattern_slice_record(&job->ctx->worker[worker], slice,
+                         (last - first) * row, start);
+}
+
+/**
+ * Writes the whole value matrix of n into memory on every pool worker,
+ * each first-touching its own rows (see pattern_render_spread)
+ *
+ * @param dst pattern_matrix_bytes(n) bytes
+ */
+static inline void pattern_matrix_spread(pattern_ctx *ctx, size_t n,
+                                         char *dst, int populate) {
+    size_t bytes = (size_t)pattern_matrix_bytes(n);
+    if (ctx->pool.count < 2 || bytes < ctx->parallel_min) {
+        if (populate) {
+            pattern_populate(dst, bytes);
+        }
+        pattern_matrix_rows(dst, n, 0, 2 * n - 1);
+        ctx->spread = 0;
+        return;
+    }
+    pattern_matrix_job job = {ctx, n, dst, populate};
+    pattern_pool_run(&ctx->pool, pattern_matrix_run, &job);
+    ctx->spread = ctx->pool.count;
+}
+
+/**
+ * Exports the value matrix of n, with a .npy header when `npy` is set
+ *
+ * With `file`, the array goes straight into the output file's pages
+ * (pattern_file_map: the output must be a regular file open for reading
+ * and writing); otherwise it is built in a buffer from
+ * pattern_map_buffer() and written out, which also works on pipes.
+ * ctx->pages and ctx->populate apply to both, as for the text sinks.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_matrix_write(pattern_ctx *ctx, size_t n, int npy,
+                                       int file) {
+    char header[PATTERN_NPY_HEADER_MAX];
+    size_t head = npy ? pattern_matrix_npy_header(header, n) : 0;
+    size_t bytes = head + (size_t)pattern_matrix_bytes(n);
+    if (pattern_ctx_flush(ctx) != 0) {
+        return -1;
+    }
+
+    if (file) {
+        pattern_file_span span;
+        char *dst = pattern_file_map(ctx, bytes, &span);
+        if (dst == NULL) {
+            return -1;
+        }
+        memcpy(dst, header, head);
+        pattern_matrix_spread(ctx, n, dst + head, ctx->populate);
+        return pattern_file_unmap(ctx, &span);
+    }
+
+    size_t size = bytes;
+    ctx->pages_used = ctx->pages;
+    char *buf = pattern_map_buffer(&size, &ctx->pages_used, 0);
+    if (buf == NULL) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+    memcpy(buf, header, head);
+    pattern_matrix_spread(ctx, n, buf + head, ctx->populate);
+    int status = pattern_writer_ref(&ctx->out, buf, bytes) == 0 &&
+                         pattern_writer_flush(&ctx->out) == 0
+                     ? 0
+                     : -1;
+    pattern_unmap(buf, size);
+    return status;
+}
+
+#endif // PATTERN_MATRIX_H
@@ -0,0 +1,201 @@
+/**
+ * pattern_numa.h
+ *
+ * CPU and memory-node topology for the render pool.
+ *
+ * On a multi-socket machine each socket has its own memory controllers,
+ * and a page lives on the node of the CPU that first wrote it (Linux's
+ * default first-touch policy). A render that is split into row slices
+ * therefore keeps its output local when every worker stays on one node
+ * and is the first to touch its own slice. This header covers the CPU
+ * side: the online CPUs grouped by node, a placement of workers onto
+ * them, and pinning; pattern_render_spread() does the touching. It reads
+ * sysfs and uses raw syscalls, so it needs no libnuma; without NUMA
+ * information the machine is one node.
+ *
+ * Placement gives consecutive workers to the same node:
+ *
+ *   8 workers, 2 nodes:  workers 0-3 on node 0, workers 4-7 on node 1
+ *
+ * Consecutive workers render consecutive row slices, so each node ends
+ * up owning one contiguous half of the output.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_NUMA_H
+#define PATTERN_NUMA_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Limits of the topology table
+#define PATTERN_MAX_NODES 64
+#define PATTERN_MAX_CPUS  CPU_SETSIZE
+
+typedef struct pattern_numa {
+    int nodes;                          // nodes with usable CPUs
+    int node_id[PATTERN_MAX_NODES];     // sysfs number of each
+    int first[PATTERN_MAX_NODES + 1];   // node i owns cpu[first[i]..)
+    int cpu[PATTERN_MAX_CPUS];
+} pattern_numa;
+
+/**
+ * Adds the CPUs of a sysfs cpulist ("0-3,8-11") that are also in
+ * `allowed` to the table
+ */
+static inline void pattern_numa_add(pattern_numa *numa, const char *list,
+                                    const cpu_set_t *allowed) {
+    int count = numa->first[numa->nodes];
+    while (*list != '\0' && *list != '\n') {
+        char *end;
+        long lo = strtol(list, &end, 10);
+        long hi = *end == '-' ? strtol(end + 1, &end, 10) : lo;
+        for (long c = lo; c <= hi && c < PATTERN_MAX_CPUS; c++) {
+            if (c >= 0 && CPU_ISSET((int)c, allowed)) {
+                numa->cpu[count++] = (int)c;
+            }
+        }
+        list = *end == ',' ? end + 1 : end;
+        if (end == list && *list != '\0') {
+            break;                      // malformed, keep what we have
+        }
+    }
+    numa->first[numa->nodes + 1] = count;
+}
+
+/**
+ * Reads the topology, restricted to the CPUs this process may run on
+ *
+ * Nodes without such CPUs (memory-only nodes, or excluded by taskset)
+ * are left out.
+ */
+static inline void pattern_numa_load(pattern_numa *numa) {
+    memset(numa, 0, sizeof(*numa));
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        CPU_ZERO(&allowed);
+        CPU_SET(0, &allowed);
+    }
+
+    for (int id = 0; id < PATTERN_MAX_NODES; id++) {
+        char path[64];
+        char list[4096];
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpulist", id);
+        FILE *f = fopen(path, "r");
+        if (f == NULL) {
+            continue;
+        }
+        int ok = fgets(list, sizeof(list), f) != NULL;
+        fclose(f);
+        if (!ok) {
+            continue;
+        }
+        pattern_numa_add(numa, list, &allowed);
+        if (numa->first[numa->nodes + 1] > numa->first[numa->nodes]) {
+            numa->node_id[numa->nodes++] = id;
+        }
+    }
+
+    if (numa->nodes == 0) {
+        // No sysfs node directory: one node holding every allowed CPU
+        int count = 0;
+        for (int c = 0; c < PATTERN_MAX_CPUS; c++) {
+            if (CPU_ISSET(c, &allowed)) {
+                numa->cpu[count++] = c;
+            }
+        }
+        numa->nodes = 1;
+        numa->first[1] = count > 0 ? count : 1;
+    }
+}
+
+/**
+ * Node index (into numa->node_id) for worker `worker` of `workers`
+ */
+static inline int pattern_numa_place(const pattern_numa *numa, int worker,
+                                     int workers) {
+    return (int)((long)worker * numa->nodes / workers);
+}
+
+/**
+ * CPU for worker `worker` of `workers`: the workers sharing a node take
+ * its CPUs in turn
+ */
+static inline int pattern_numa_cpu(const pattern_numa *numa, int worker,
+                                   int workers) {
+    int node = pattern_numa_place(numa, worker, workers);
+    int lead = 0;                       // first worker placed on `node`
+    while (pattern_numa_place(numa, lead, workers) != node) {
+        lead++;
+    }
+    int cpus = numa->first[node + 1] - numa->first[node];
+    return numa->cpu[numa->first[node] + (worker - lead) % cpus];
+}
+
+/**
+ * Binds a thread to one CPU
+ *
+ * @return 0 on success, otherwise an errno value
+ */
+static inline int pattern_numa_pin(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread, sizeof(set), &set);
+}
+
+/**
+ * Node the calling thread is running on, or -1 if unknown
+ */
+static inline int pattern_numa_current(void) {
+    unsigned cpu;
+    unsigned node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+        return -1;
+    }
+    return (int)node;
+}
+
+/**
+ * Counts how many of `count` pages spread evenly over [p, p+size) are
+ * on `node`, with move_pages(2) in query mode
+ *
+ * @return Pages found on the node, or -1 if the kernel cannot tell
+ */
+static inline int pattern_numa_local(const char *p, size_t size, int count,
+                                     int node) {
+    void *pages[64];
+    int status[64];
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if (count > 64) {
+        count = 64;
+    }
+    if (size < page || count < 1) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        size_t at = size / (size_t)count * (size_t)i;
+        pages[i] = (void *)((uintptr_t)(p + at) & ~(uintptr_t)(page - 1));
+    }
+    if (syscall(SYS_move_pages, 0, (unsigned long)count, pages, NULL,
+                status, 0) != 0) {
+        return -1;
+    }
+    int local = 0;
+    for (int i = 0; i < count; i++) {
+        local += status[i] == node;
+    }
+    return local;
+}
+
+#endif // PATTERN_NUMA_H
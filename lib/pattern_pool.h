@@ -0,0 +1,313 @@
+/**
+ * pattern_pool.h
+ *
+ * Persistent worker threads for the render context.
+ *
+ * The pool runs two kinds of work:
+ *   - jobs: pattern_pool_run() hands the same job to every worker and
+ *     waits for all of them (one row slice each, a static split)
+ *   - tasks: small independent pieces (a chunk of rows) queued with
+ *     pattern_pool_push() and run by whichever worker gets to them
+ *
+ * Tasks live in one deque per worker. A worker takes the oldest task of
+ * its own deque; when that is empty it steals the newest task of another
+ * worker's deque, so no worker sits idle while another still has a
+ * backlog, however unevenly the tasks were dealt out or however long
+ * they take. Owners taking the oldest first also makes tasks finish
+ * roughly in the order they were queued, which is the order their
+ * output is needed in.
+ *
+ * Deques are guarded by a mutex each rather than being lock-free: a task
+ * formats hundreds of kilobytes, so the lock is never the bottleneck.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_POOL_H
+#define PATTERN_POOL_H
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Upper bound on worker threads
+#define PATTERN_MAX_THREADS 256
+
+// Tasks one worker's deque holds (a power of two)
+#define PATTERN_DEQUE_SIZE 256
+
+/**
+ * One piece of stealable work: run(arg, index, worker)
+ */
+typedef struct pattern_task {
+    void (*run)(void *arg, size_t index, int worker);
+    void *arg;
+    size_t index;
+} pattern_task;
+
+typedef struct pattern_deque {
+    pthread_mutex_t lock;
+    size_t top;                 // oldest task, taken by the owner
+    size_t bottom;              // one past the newest, stolen from here
+    pattern_task task[PATTERN_DEQUE_SIZE];
+} pattern_deque;
+
+typedef struct pattern_pool {
+    pthread_t threads[PATTERN_MAX_THREADS];
+    int count;                      // workers including the caller
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t idle;
+    pthread_cond_t done;            // a task group finished
+    unsigned long generation;       // bumped for every job
+    int pending;                    // helpers still running the job
+    int stop;
+    void (*job)(void *arg, int worker);
+    void *arg;
+    pattern_deque *deque;           // one per worker
+    int queued;                     // tasks in the deques (atomic)
+    int sleeping;                   // threads in a cond wait (atomic)
+} pattern_pool;
+
+typedef struct pattern_pool_seat {
+    pattern_pool *pool;
+    int worker;
+} pattern_pool_seat;
+
+/**
+ * Takes a task: the oldest of the worker's own deque, or else the
+ * newest of the first other deque that has one
+ *
+ * @param oldest Take the oldest task of other deques too; for a thread
+ *               waiting on the earliest queued group (pattern_pool_help)
+ * @return 1 if `task` was filled in, 0 if every deque is empty
+ */
+static inline int pattern_pool_take(pattern_pool *pool, int worker,
+                                    int oldest, pattern_task *task) {
+    if (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+    for (int v = 0; v < pool->count; v++) {
+        pattern_deque *d = &pool->deque[(worker + v) % pool->count];
+        int found = 0;
+        pthread_mutex_lock(&d->lock);
+        if (d->top < d->bottom) {
+            size_t at = v == 0 || oldest ? d->top++ : --d->bottom;
+            *task = d->task[at % PATTERN_DEQUE_SIZE];
+            found = 1;
+        }
+        pthread_mutex_unlock(&d->lock);
+        if (found) {
+            __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_RELEASE);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Queues a task on a worker's deque; pattern_pool_wake() then starts
+ * the sleeping workers on it
+ *
+ * @return 0 on success, -1 if that deque is full (run the task inline)
+ */
+static inline int pattern_pool_push(pattern_pool *pool, int worker,
+                                    pattern_task task) {
+    pattern_deque *d = &pool->deque[worker];
+    pthread_mutex_lock(&d->lock);
+    int full = d->bottom - d->top == PATTERN_DEQUE_SIZE;
+    if (!full) {
+        d->task[d->bottom++ % PATTERN_DEQUE_SIZE] = task;
+    }
+    pthread_mutex_unlock(&d->lock);
+    if (full) {
+        return -1;
+    }
+
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+    return 0;
+}
+
+/**
+ * Wakes the workers sleeping while tasks were pushed
+ *
+ * Called once per batch of pushes rather than per task: on a busy
+ * machine every wakeup can preempt the pushing thread.
+ */
+static inline void pattern_pool_wake(pattern_pool *pool) {
+    // Sleepers count themselves under the lock before checking `queued`,
+    // so either they see the new tasks or this sees them
+    if (__atomic_load_n(&pool->sleeping, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * Called by a task that completed a group someone may be waiting for
+ * (see pattern_pool_help())
+ */
+static inline void pattern_pool_done(pattern_pool *pool) {
+    if (__atomic_load_n(&pool->sleeping, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * Runs queued tasks on the calling thread (worker 0) until *pending,
+ * which the tasks count down, reaches zero
+ *
+ * The last task of the group must call pattern_pool_done() after its
+ * decrement.
+ */
+static inline void pattern_pool_help(pattern_pool *pool, const int *pending) {
+    while (__atomic_load_n(pending, __ATOMIC_ACQUIRE) > 0) {
+        pattern_task task;
+        if (pattern_pool_take(pool, 0, 1, &task)) {
+            task.run(task.arg, task.index, 0);
+            continue;
+        }
+        // The rest is running on other workers
+        pthread_mutex_lock(&pool->lock);
+        __atomic_add_fetch(&pool->sleeping, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(pending, __ATOMIC_SEQ_CST) > 0 &&
+               __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0) {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+        __atomic_sub_fetch(&pool->sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static inline void *pattern_pool_main(void *arg) {
+    pattern_pool_seat seat = *(pattern_pool_seat *)arg;
+    pattern_pool *pool = seat.pool;
+    free(arg);
+
+    unsigned long seen = 0;
+    for (;;) {
+        pattern_task task;
+        if (pattern_pool_take(pool, seat.worker, 0, &task)) {
+            task.run(task.arg, task.index, seat.worker);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        __atomic_add_fetch(&pool->sleeping, 1, __ATOMIC_SEQ_CST);
+        while (!pool->stop && pool->generation == seen &&
+               __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        __atomic_sub_fetch(&pool->sleeping, 1, __ATOMIC_SEQ_CST);
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        if (pool->generation != seen) {
+            seen = pool->generation;
+            pthread_mutex_unlock(&pool->lock);
+
+            pool->job(pool->arg, seat.worker);
+
+            pthread_mutex_lock(&pool->lock);
+            if (--pool->pending == 0) {
+                pthread_cond_signal(&pool->idle);
+            }
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+/**
+ * Starts `count - 1` helper threads (the caller is the remaining one)
+ *
+ * @return Number of workers actually available (at least 1)
+ */
+static inline int pattern_pool_start(pattern_pool *pool, int count) {
+    memset(pool, 0, sizeof(*pool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->count = 1;
+
+    if (count > PATTERN_MAX_THREADS) {
+        count = PATTERN_MAX_THREADS;
+    }
+    pool->deque = calloc((size_t)count, sizeof(*pool->deque));
+    if (pool->deque == NULL) {
+        count = 1;
+        pool->deque = calloc(1, sizeof(*pool->deque));
+    }
+    for (int t = 0; t < count && pool->deque != NULL; t++) {
+        pthread_mutex_init(&pool->deque[t].lock, NULL);
+    }
+    for (int t = 1; t < count; t++) {
+        pattern_pool_seat *seat = malloc(sizeof(*seat));
+        if (seat == NULL) {
+            break;
+        }
+        seat->pool = pool;
+        seat->worker = t;
+        if (pthread_create(&pool->threads[t], NULL, pattern_pool_main,
+                           seat) != 0) {
+            free(seat);
+            break;
+        }
+        pool->count++;
+    }
+    return pool->count;
+}
+
+/**
+ * Runs job(arg, worker) on every worker and waits for completion
+ */
+static inline void pattern_pool_run(pattern_pool *pool,
+                                    void (*job)(void *, int), void *arg) {
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->arg = arg;
+    pool->pending = pool->count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    job(arg, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Stops the helpers; every queued task must have been run
+ */
+static inline void pattern_pool_stop(pattern_pool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int t = 1; t < pool->count; t++) {
+        pthread_join(pool->threads[t], NULL);
+    }
+    for (int t = 0; t < pool->count && pool->deque != NULL; t++) {
+        pthread_mutex_destroy(&pool->deque[t].lock);
+    }
+    free(pool->deque);
+    pool->deque = NULL;
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->done);
+}
+
+#endif // PATTERN_POOL_H
@@ -0,0 +1,471 @@
+/**
+ * pattern_ranges.hpp
+ *
+ * Both patterns as C++20 ranges and coroutine generators, row by row
+ * or cell by cell.
+ *
+ *   #include "pattern_ranges.hpp"
+ *
+ *   for (std::string_view row : pattern::views::triangle(n)) {
+ *       std::cout << row;                       // "* * \n", ...
+ *   }
+ *   for (auto row : pattern::views::concentric(n)
+ *                       | std::views::drop(n - 1) | std::views::take(1)) {
+ *       std::cout << row;                       // the middle row only
+ *   }
+ *
+ * The views sit on the engines of pattern_format.hpp, with the same
+ * format policies. Building a view formats what the engine formats
+ * once per pattern: the triangle's master row, or the concentric
+ * square's two ladders, O(n) bytes held by a shared_ptr. After that a
+ * row is never rendered in advance. A triangle row is a string_view
+ * slice of the master, newline included. A concentric row is a
+ * concentric_row, which describes the row as a ladder prefix, a
+ * repeated plateau cell and a ladder suffix, and is only copied out when
+ * printed or asked to. Both views are random access and sized, so
+ * views::drop and views::take jump straight to the rows they keep.
+ * Rows stay valid while any copy of their view is alive.
+ *
+ * views::concentric_cells(n) is every cell value in row-major order,
+ * computed from its position (max(|i-c|, |j-c|) + 1) with nothing
+ * stored.
+ *
+ * generate_triangle(), generate_concentric() and generate_cells()
+ * yield the same things from a coroutine, for code that wants a
+ * generator. pattern::generator<T> is a minimal std::generator-style
+ * input range; GCC 12 has no <generator>. A generator renders nothing
+ * for rows that are never resumed, and skipping one costs a resume.
+ *
+ * Compile: g++ -std=c++20 -O2 program.cpp
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_RANGES_HPP
+#define PATTERN_RANGES_HPP
+
+#include <compare>
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <utility>
+
+#include "pattern_format.hpp"
+
+namespace pattern {
+
+namespace detail {
+
+/**
+ * Random-access iterator over rows 0..count-1 of a source, a small
+ * copyable object whose row(k) makes row k on demand
+ */
+template <class Source>
+class row_iterator {
+public:
+    using value_type = decltype(std::declval<const Source &>().row(0));
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::random_access_iterator_tag;
+
+    row_iterator() = default;
+    row_iterator(Source source, difference_type k)
+        : source_(source), k_(k) {}
+
+    value_type operator*() const {
+        return source_.row(static_cast<std::size_t>(k_));
+    }
+    value_type operator[](difference_type d) const {
+        return source_.row(static_cast<std::size_t>(k_ + d));
+    }
+
+    row_iterator &operator++() {
+        k_++;
+        return *this;
+    }
+    row_iterator operator++(int) {
+        row_iterator was = *this;
+        k_++;
+        return was;
+    }
+    row_iterator &operator--() {
+        k_--;
+        return *this;
+    }
+    row_iterator operator--(int) {
+        row_iterator was = *this;
+        k_--;
+        return was;
+    }
+    row_iterator &operator+=(difference_type d) {
+        k_ += d;
+        return *this;
+    }
+    row_iterator &operator-=(difference_type d) {
+        k_ -= d;
+        return *this;
+    }
+    friend row_iterator operator+(row_iterator it, difference_type d) {
+        return it += d;
+    }
+    friend row_iterator operator+(difference_type d, row_iterator it) {
+        return it += d;
+    }
+    friend row_iterator operator-(row_iterator it, difference_type d) {
+        return it -= d;
+    }
+    friend difference_type operator-(const row_iterator &a,
+                                     const row_iterator &b) {
+        return a.k_ - b.k_;
+    }
+    friend bool operator==(const row_iterator &a, const row_iterator &b) {
+        return a.k_ == b.k_;
+    }
+    friend auto operator<=>(const row_iterator &a, const row_iterator &b) {
+        return a.k_ <=> b.k_;
+    }
+
+private:
+    Source source_{};
+    difference_type k_ = 0;
+};
+
+/**
+ * Rows of the triangle: row k (0-based) is the last row_bytes(k + 1)
+ * bytes of the master
+ */
+template <class Format>
+struct triangle_source {
+    const char *end = nullptr;
+
+    std::string_view row(std::size_t k) const {
+        std::size_t len = Format::row_bytes(k + 1);
+        return {end - len, len};
+    }
+};
+
+} // namespace detail
+
+/**
+ * One row of a concentric square, not yet formatted: the first cells
+ * of the descending ladder, the plateau cell repeated, the last cells
+ * of the ascending ladder, and a newline
+ */
+template <class Format = concentric_format<>>
+class concentric_row {
+public:
+    using ladders = typename Format::ladders;
+
+    concentric_row() = default;
+    concentric_row(const ladders *lad, std::size_t plateau)
+        : lad_(lad), p_(plateau) {}
+
+    std::size_t plateau() const { return p_; }
+
+    // Bytes once formatted, newline included
+    std::size_t size() const { return lad_->row_bytes(p_); }
+
+    std::string_view left() const {
+        return {lad_->desc.get(), outer()};
+    }
+    std::string_view cell() const {
+        return {lad_->desc.get() + lad_->desc_at[p_],
+                Format::cell_bytes(p_, lad_->n)};
+    }
+    std::size_t repeats() const { return 2 * p_ - 1; }
+    std::string_view right() const {
+        return {lad_->asc.get() + lad_->asc_at[p_ + 1], outer()};
+    }
+
+    /**
+     * Formats the row into dst, which holds at least size() bytes
+     *
+     * @return Bytes written, size()
+     */
+    std::size_t copy(char *dst) const { return lad_->row(dst, p_); }
+
+    std::string str() const {
+        std::string out(size(), '\0');
+        copy(out.data());
+        return out;
+    }
+
+    /**
+     * Cell values of the row, left to right: cell j is the larger of
+     * the plateau and its own distance from the middle column, plus 1
+     */
+    auto values() const {
+        std::size_t n = lad_->n;
+        std::size_t p = p_;
+        return std::views::iota(std::size_t{0}, 2 * n - 1) |
+               std::views::transform([n, p](std::size_t j) {
+                   std::size_t d = (j < n - 1 ? n - 1 - j : j - (n - 1)) + 1;
+                   return d > p ? d : p;
+               });
+    }
+
+    friend std::ostream &operator<<(std::ostream &os,
+                                    const concentric_row &row) {
+        os << row.left();
+        for (std::size_t i = 0; i < row.repeats(); i++) {
+            os << row.cell();
+        }
+        return os << row.right() << '\n';
+    }
+
+private:
+    std::size_t outer() const {
+        return lad_->asc_at[lad_->n + 1] - lad_->asc_at[p_ + 1];
+    }
+
+    const ladders *lad_ = nullptr;
+    std::size_t p_ = 0;
+};
+
+namespace detail {
+
+template <class Format>
+struct concentric_source {
+    const typename Format::ladders *lad = nullptr;
+
+    concentric_row<Format> row(std::size_t k) const {
+        return {lad, Format::plateau(lad->n, k)};
+    }
+};
+
+} // namespace detail
+
+/**
+ * Rows of a triangle, as string_view slices of one master row
+ */
+template <class Format = triangle_format<>>
+class triangle_rows
+    : public std::ranges::view_interface<triangle_rows<Format>> {
+public:
+    using iterator = detail::row_iterator<detail::triangle_source<Format>>;
+
+    triangle_rows() = default;
+    explicit triangle_rows(std::size_t n)
+        : master_(Format::master(n)), n_(n) {}
+
+    iterator begin() const { return {source(), 0}; }
+    iterator end() const {
+        return {source(), static_cast<std::ptrdiff_t>(n_)};
+    }
+    std::size_t size() const { return n_; }
+
+private:
+    detail::triangle_source<Format> source() const {
+        return {master_ ? master_.get() + Format::row_bytes(n_) : nullptr};
+    }
+
+    std::shared_ptr<const char[]> master_;
+    std::size_t n_ = 0;
+};
+
+/**
+ * Rows of a concentric square, as concentric_row descriptions over one
+ * pair of ladders
+ */
+template <class Format = concentric_format<>>
+class concentric_rows
+    : public std::ranges::view_interface<concentric_rows<Format>> {
+public:
+    using iterator = detail::row_iterator<detail::concentric_source<Format>>;
+
+    concentric_rows() = default;
+    explicit concentric_rows(std::size_t n)
+        : lad_(n > 0 ? std::make_shared<const typename Format::ladders>(n)
+                     : nullptr),
+          rows_(n > 0 ? 2 * n - 1 : 0) {}
+
+    iterator begin() const { return {{lad_.get()}, 0}; }
+    iterator end() const {
+        return {{lad_.get()}, static_cast<std::ptrdiff_t>(rows_)};
+    }
+    std::size_t size() const { return rows_; }
+
+private:
+    std::shared_ptr<const typename Format::ladders> lad_;
+    std::size_t rows_ = 0;
+};
+
+namespace views {
+
+template <class Format = triangle_format<>>
+triangle_rows<Format> triangle(std::size_t n) {
+    return triangle_rows<Format>(n);
+}
+
+template <class Format = concentric_format<>>
+concentric_rows<Format> concentric(std::size_t n) {
+    return concentric_rows<Format>(n);
+}
+
+/**
+ * Every cell value of the concentric square for n, row-major
+ */
+inline auto concentric_cells(std::size_t n) {
+    std::size_t side = n > 0 ? 2 * n - 1 : 0;
+    return std::views::iota(std::size_t{0}, side * side) |
+           std::views::transform([n, side](std::size_t at) {
+               std::size_t i = at / side;
+               std::size_t j = at % side;
+               std::size_t di = i < n - 1 ? n - 1 - i : i - (n - 1);
+               std::size_t dj = j < n - 1 ? n - 1 - j : j - (n - 1);
+               return (di > dj ? di : dj) + 1;
+           });
+}
+
+} // namespace views
+
+/* ------------------------------------------------------------------ */
+/* Generators                                                          */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Coroutine yielding values of type T, consumed as an input range;
+ * a value stays valid until the generator is resumed
+ */
+template <class T>
+class generator : public std::ranges::view_base {
+public:
+    struct promise_type {
+        const T *value = nullptr;
+        std::exception_ptr error;
+
+        generator get_return_object() {
+            return generator(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T &v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+        // Generators only yield
+        template <class U>
+        std::suspend_never await_transform(U &&) = delete;
+    };
+
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> h) : h_(h) {}
+
+        const T &operator*() const { return *h_.promise().value; }
+        iterator &operator++() {
+            resume(h_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        friend bool operator==(const iterator &it, std::default_sentinel_t) {
+            return !it.h_ || it.h_.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> h_;
+    };
+
+    generator() = default;
+    generator(generator &&other) noexcept
+        : h_(std::exchange(other.h_, {})) {}
+    generator &operator=(generator &&other) noexcept {
+        if (this != &other) {
+            if (h_) {
+                h_.destroy();
+            }
+            h_ = std::exchange(other.h_, {});
+        }
+        return *this;
+    }
+    ~generator() {
+        if (h_) {
+            h_.destroy();
+        }
+    }
+
+    iterator begin() {
+        if (h_) {
+            resume(h_);
+        }
+        return iterator(h_);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit generator(std::coroutine_handle<promise_type> h) : h_(h) {}
+
+    static void resume(std::coroutine_handle<promise_type> h) {
+        h.resume();
+        if (h.promise().error) {
+            std::rethrow_exception(std::exchange(h.promise().error, {}));
+        }
+    }
+
+    std::coroutine_handle<promise_type> h_;
+};
+
+/**
+ * Rows of a triangle, each a slice of a master held by the coroutine
+ */
+template <class Format = triangle_format<>>
+generator<std::string_view> generate_triangle(std::size_t n) {
+    auto master = Format::master(n);
+    const char *end = master.get() + Format::row_bytes(n);
+    for (std::size_t r = 1; r <= n; r++) {
+        co_yield std::string_view(end - Format::row_bytes(r),
+                                  Format::row_bytes(r));
+    }
+}
+
+/**
+ * Rows of a concentric square, over ladders held by the coroutine
+ */
+template <class Format = concentric_format<>>
+generator<concentric_row<Format>> generate_concentric(std::size_t n) {
+    if (n == 0) {
+        co_return;
+    }
+    typename Format::ladders lad(n);
+    for (std::size_t k = 0; k < 2 * n - 1; k++) {
+        co_yield concentric_row<Format>(&lad, Format::plateau(n, k));
+    }
+}
+
+/**
+ * Cell values of a concentric square, row-major
+ */
+inline generator<std::size_t> generate_cells(std::size_t n) {
+    for (std::size_t i = 0; i + 1 < 2 * n; i++) {
+        std::size_t di = i < n - 1 ? n - 1 - i : i - (n - 1);
+        for (std::size_t j = 0; j + 1 < 2 * n; j++) {
+            std::size_t dj = j < n - 1 ? n - 1 - j : j - (n - 1);
+            co_yield (di > dj ? di : dj) + 1;
+        }
+    }
+}
+
+// What views::take and views::drop rely on
+static_assert(std::ranges::view<triangle_rows<>>);
+static_assert(std::ranges::random_access_range<triangle_rows<>>);
+static_assert(std::ranges::sized_range<concentric_rows<>>);
+static_assert(std::ranges::random_access_range<concentric_rows<>>);
+static_assert(std::ranges::random_access_range<
+              decltype(views::concentric_cells(1))>);
+static_assert(std::ranges::input_range<generator<std::string_view>>);
+static_assert(std::ranges::view<generator<std::size_t>>);
+
+} // namespace pattern
+
+#endif // PATTERN_RANGES_HPP
@@ -0,0 +1,1082 @@
+/**
+ * pattern_render.h
+ *
+ * Render context shared by every request a program handles.
+ *
+ * A context owns everything that is worth keeping warm between renders:
+ * the triangle master row, the concentric ladders, the output writer and
+ * a pool of worker threads. Masters only ever grow, so a batch of
+ * thousands of sizes formats each of them once for the largest n.
+ *
+ * Both patterns are addressed the same way, as a list of rows:
+ *   - triangle:   row k (0-based) has k+1 stars
+ *   - concentric: row k has plateau value concentric_row_plateau(n, k)
+ * which lets the parallel path below split any pattern into row slices
+ * with exact byte offsets.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_RENDER_H
+#define PATTERN_RENDER_H
+
+#include <stdlib.h>
+
+#include "pattern_concentric.h"
+#include "pattern_numa.h"
+#include "pattern_pool.h"
+#include "pattern_triangle.h"
+
+// Patterns the library can render
+#define PATTERN_TRIANGLE   0
+#define PATTERN_CONCENTRIC 1
+#define PATTERN_SHAPES     2
+
+static const char *const pattern_shape_names[PATTERN_SHAPES] = {
+    "triangle",
+    "concentric",
+};
+
+// Largest n accepted (keeps every size computation inside 64 bits)
+#define PATTERN_MAX_N 100000000ULL
+
+// Patterns smaller than this are not worth waking the pool for; the
+// default of ctx->parallel_min, which a machine profile may change
+#define PATTERN_PARALLEL_MIN (4u << 20)
+
+// Large patterns are queued as segments of about this many bytes, one
+// reorder buffer slot each, cut into stealable chunks of about
+// PATTERN_CHUNK_BYTES
+#define PATTERN_SEGMENT_BYTES  (512u << 10)
+#define PATTERN_CHUNK_BYTES    (64u << 10)
+#define PATTERN_SEGMENT_CHUNKS 32
+
+// Segments in flight at once: PATTERN_REORDER_PER_WORKER per worker, at
+// most PATTERN_REORDER_SLOTS. More only adds slot buffers that have
+// dropped out of the cache by the time they are reused.
+#define PATTERN_REORDER_SLOTS      16
+#define PATTERN_REORDER_PER_WORKER 2
+
+// Store policy for whole-pattern renders into memory
+#define PATTERN_STREAM_AUTO 0   // non-temporal above the last-level cache
+#define PATTERN_STREAM_OFF  1
+#define PATTERN_STREAM_ON   2
+
+/**
+ * Looks up a shape by name
+ *
+ * @return Shape index, or -1 if the name is unknown
+ */
+static inline int pattern_shape_parse(const char *name) {
+    for (int s = 0; s < PATTERN_SHAPES; s++) {
+        if (strcmp(name, pattern_shape_names[s]) == 0) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Parses a size, accepting only 1..PATTERN_MAX_N
+ *
+ * @return 0 on success, -1 if `text` is not a valid size
+ */
+static inline int pattern_parse_size(const char *text, size_t *n) {
+    char *end;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    while (*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n') {
+        end++;
+    }
+    if (errno != 0 || end == text || *end != '\0' || text[0] == '-' ||
+        value == 0 || value > PATTERN_MAX_N) {
+        return -1;
+    }
+    *n = (size_t)value;
+    return 0;
+}
+
+/**
+ * Checks one kernel variant against the scalar one
+ *
+ * Runs both on the same inputs and compares the bytes: the fill kernel
+ * for token lengths 1..12 and a few longer ones, and the streaming copy
+ * of each fill, over lengths short and long and alignments spread over
+ * a vector; then the concentric value kernel over whole rows and row
+ * tails of several sizes, and the narrowing store of those values to
+ * one and two bytes at every offset of a vector. Guards around each
+ * output catch stores that run over.
+ *
+ * @param isa PATTERN_ISA_*; must be supported by this CPU
+ * @return 0 if every output matched, -1 on a mismatch or if out of memory
+ */
+static inline int pattern_kernels_check(int isa) {
+    static const size_t token_lens[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                        12, 24, 40};
+    static const size_t long_lens[] = {511, 4096, 4097, 65543};
+    static const size_t sizes[] = {1, 2, 3, 8, 17, 100, 1000};
+    size_t cap = 65543 + 128;
+    char *want = malloc(cap);
+    char *got = malloc(cap);
+    uint32_t *want_cells = malloc(2048 * sizeof(uint32_t));
+    uint32_t *got_cells = malloc(2048 * sizeof(uint32_t));
+    int status = want && got && want_cells && got_cells ? 0 : -1;
+    char token[40];
+    for (size_t b = 0; b < sizeof(token); b++) {
+        token[b] = (char)('A' + b % 26);
+    }
+
+    for (size_t t = 0; status == 0 && t < sizeof(token_lens) /
+                                            sizeof(token_lens[0]); t++) {
+        size_t token_len = token_lens[t];
+        // Every length below 300, then the long ones
+        for (size_t k = 1; status == 0 &&
+             k < 300 + sizeof(long_lens) / sizeof(long_lens[0]); k++) {
+            size_t total = k < 300 ? k : long_lens[k - 300];
+            for (size_t align = 0; status == 0 && align < 64; align += 7) {
+                memset(want, '.', total + 128);
+                memset(got, '.', total + 128);
+                pattern_fill_scalar(want + align, token, token_len, total);
+                pattern_fill_variants[isa](got + align, token, token_len,
+                                           total);
+                if (memcmp(want, got, total + 128) != 0) {
+                    status = -1;
+                }
+
+                // Streaming copy of the same bytes, shifted by `align`
+                memset(got, '.', total + 128);
+                pattern_copy_stream_variants[isa](got + 64 - align,
+                                                  want + align, total);
+                pattern_stream_fence();
+                if (memcmp(got + 64 - align, want + align, total) != 0 ||
+                    got[64 - align + total] != '.' ||
+                    (align < 64 && got[63 - align] != '.')) {
+                    status = -1;
+                }
+            }
+        }
+    }
+
+    for (size_t s = 0; status == 0 && s < sizeof(sizes) / sizeof(sizes[0]);
+         s++) {
+        size_t n = sizes[s];
+        size_t side = 2 * n - 1;
+        for (size_t i = 0; status == 0 && i < side; i++) {
+            for (size_t from = 0; status == 0 && from < side && from < 20;
+                 from += 3) {
+                size_t count = side - from;
+                memset(want_cells, 0xa5, (count + 16) * sizeof(uint32_t));
+                memset(got_cells, 0xa5, (count + 16) * sizeof(uint32_t));
+                concentric_cell_row_scalar(want_cells, n, i, from, count);
+                concentric_cell_row_variants[isa](got_cells, n, i, from,
+                                                  count);
+                if (memcmp(want_cells, got_cells,
+                           (count + 16) * sizeof(uint32_t)) != 0) {
+                    status = -1;
+                }
+
+                // One byte only holds the values of n up to 255
+                for (size_t width = n <= 255 ? 1 : 2;
+                     status == 0 && width <= 2; width++) {
+                    size_t align = (i + from) % 64;
+                    size_t span = count * width + 128;
+                    memset(want, '.', span);
+                    memset(got, '.', span);
+                    pattern_narrow_scalar(want + 64 + align, want_cells,
+                                          count, width);
+                    pattern_narrow_variants[isa](got + 64 + align,
+                                                 want_cells, count, width);
+                    if (memcmp(want, got, span) != 0) {
+                        status = -1;
+                    }
+                }
+            }
+        }
+    }
+
+    free(want);
+    free(got);
+    free(want_cells);
+    free(got_cells);
+    return status;
+}
+
+/**
+ * What one worker did in the last spread render (pattern_render_spread)
+ */
+typedef struct pattern_worker_stats {
+    unsigned long long bytes;
+    unsigned long long ns;
+    int node;                   // node it finished on, -1 if unknown
+    int sampled;                // pages of its slice checked
+    int local;                  // of those, pages on its node (-1: unknown)
+} pattern_worker_stats;
+
+struct pattern_ctx;
+
+/**
+ * One slot of the reorder buffer: a stretch of output formatted either
+ * by pool tasks (the rows of part of a large pattern) or inline by the
+ * submitting thread (small patterns and headers queued behind it)
+ */
+typedef struct pattern_segment {
+    const struct pattern_ctx *ctx;
+    pattern_pool *pool;
+    int shape;                  // -1 for an inline slot
+    size_t n;
+    char *buf;
+    size_t cap;                 // bytes mapped at buf
+    size_t bytes;               // bytes of output in buf
+    int pending;                // chunks not formatted yet (atomic)
+    int chunks;
+    size_t first[PATTERN_SEGMENT_CHUNKS + 1];   // rows of chunk c
+    size_t offset[PATTERN_SEGMENT_CHUNKS + 1];  // where chunk c goes
+} pattern_segment;
+
+/**
+ * Output in flight, in request order: slots [head, tail)
+ */
+typedef struct pattern_reorder {
+    pattern_segment slot[PATTERN_REORDER_SLOTS];
+    size_t head;                // oldest slot not written out yet
+    size_t tail;                // next slot to fill
+    size_t depth;               // slots in use, see PATTERN_REORDER_SLOTS
+    unsigned next;              // worker the next chunk is dealt to
+} pattern_reorder;
+
+/**
+ * Everything reused across renders
+ */
+typedef struct pattern_ctx {
+    triangle_master tri;
+    concentric_master con;
+    pattern_writer out;
+    pattern_pool pool;
+    int stream;                 // PATTERN_STREAM_*, for buffer renders
+    int pages;                  // PATTERN_PAGES_*, for the memory sinks
+    int populate;               // prefault memory sink buffers
+    int pages_used;             // policy the last memory render got
+    int pinned;                 // workers bound by pattern_ctx_pin()
+    int spread;                 // workers in the last spread render, or 0
+    size_t parallel_min;        // bytes from which the pool is used
+    pattern_worker_stats worker[PATTERN_MAX_THREADS];
+    pattern_reorder order;      // large renders still being formatted
+} pattern_ctx;
+
+/**
+ * Sets up a context writing to `fd`
+ *
+ * @param sink    PATTERN_SINK_* for the writer
+ * @param threads Worker threads for large renders (1 = render inline)
+ * @return 0 on success, -1 if the writer could not be set up
+ */
+static inline int pattern_ctx_init(pattern_ctx *ctx, int fd, int sink,
+                                   int threads) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->parallel_min = PATTERN_PARALLEL_MIN;
+    pattern_pool_start(&ctx->pool, threads < 1 ? 1 : threads);
+    size_t depth = (size_t)ctx->pool.count * PATTERN_REORDER_PER_WORKER;
+    ctx->order.depth = depth < PATTERN_REORDER_SLOTS ? depth
+                                                     : PATTERN_REORDER_SLOTS;
+    return pattern_writer_init(&ctx->out, fd, sink);
+}
+
+/**
+ * Number of rows in a pattern
+ */
+static inline size_t pattern_rows(int shape, size_t n) {
+    return shape == PATTERN_TRIANGLE ? n : 2 * n - 1;
+}
+
+/**
+ * Exact output size, from the closed forms of each shape
+ */
+static inline unsigned long long pattern_total_bytes(int shape, size_t n) {
+    return shape == PATTERN_TRIANGLE ? triangle_total_bytes(n)
+                                     : concentric_total_bytes(n);
+}
+
+/**
+ * Number of cells (stars or numbers) in a pattern
+ */
+static inline unsigned long long pattern_cells(int shape, size_t n) {
+    return shape == PATTERN_TRIANGLE
+               ? (unsigned long long)n * (n + 1) / 2
+               : (unsigned long long)(2 * n - 1) * (2 * n - 1);
+}
+
+/**
+ * Bytes in row k (0-based)
+ */
+static inline size_t pattern_row_bytes(int shape, size_t n, size_t k) {
+    if (shape == PATTERN_TRIANGLE) {
+        return triangle_row_bytes(k + 1);
+    }
+    return (size_t)concentric_row_bytes(n, concentric_row_plateau(n, k));
+}
+
+/**
+ * Formats row k (0-based) into memory; the masters must cover n
+ *
+ * @param stream Use non-temporal stores; see pattern_render_buffer()
+ * @return Bytes written
+ */
+static inline size_t pattern_render_row(const pattern_ctx *ctx, int shape,
+                                        size_t n, size_t k, char *dst,
+                                        int stream) {
+    if (shape == PATTERN_TRIANGLE) {
+        size_t len = triangle_row_bytes(k + 1);
+        pattern_copy(dst, triangle_master_row(&ctx->tri, k + 1), len,
+                     stream);
+        return len;
+    }
+    return concentric_render_row(dst, &ctx->con, n,
+                                 concentric_row_plateau(n, k), stream);
+}
+
+/**
+ * Byte offset of row k (0-based), in closed form
+ *
+ * Triangle rows before row k hold 1..k stars: k(k+1) + k = k(k+2) bytes.
+ */
+static inline unsigned long long pattern_row_offset(int shape, size_t n,
+                                                    size_t k) {
+    if (shape == PATTERN_TRIANGLE) {
+        return (unsigned long long)k * (k + 2);
+    }
+    return concentric_row_offset(n, k);
+}
+
+/**
+ * Row containing byte `offset` (which must be below the total size)
+ *
+ * Row offsets only grow, so this is a binary search over the closed
+ * form: O(log n) evaluations instead of a walk over the rows above.
+ */
+static inline size_t pattern_find_row(int shape, size_t n,
+                                      unsigned long long offset) {
+    size_t lo = 0;
+    size_t hi = pattern_rows(shape, n) - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        if (pattern_row_offset(shape, n, mid) <= offset) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Random access: formats bytes [offset, offset+len) of a pattern
+ *
+ * Only the rows overlapping the range are touched, and the first and
+ * last of them only partially, so serving the tail of a multi-gigabyte
+ * square costs as much as its length. The masters must already cover n
+ * (pattern_ctx_reserve); a context used only for this needs no writer.
+ */
+static inline void pattern_render_range(const pattern_ctx *ctx, int shape,
+                                        size_t n, unsigned long long offset,
+                                        size_t len, char *dst) {
+    size_t k = pattern_find_row(shape, n, offset);
+    size_t from = (size_t)(offset - pattern_row_offset(shape, n, k));
+
+    while (len > 0) {
+        size_t row = pattern_row_bytes(shape, n, k);
+        size_t count = row - from < len ? row - from : len;
+        if (shape == PATTERN_TRIANGLE) {
+            memcpy(dst, triangle_master_row(&ctx->tri, k + 1) + from, count);
+        } else {
+            concentric_render_span(dst, &ctx->con, n,
+                                   concentric_row_plateau(n, k),
+                                   from, count);
+        }
+        dst += count;
+        len -= count;
+        from = 0;
+        k++;
+    }
+}
+
+/**
+ * Whether pattern_render_buffer() will use non-temporal stores for
+ * (shape, n)
+ */
+static inline int pattern_stream_wanted(const pattern_ctx *ctx, int shape,
+                                        size_t n) {
+    if (ctx->stream != PATTERN_STREAM_AUTO) {
+        return ctx->stream == PATTERN_STREAM_ON;
+    }
+    return pattern_total_bytes(shape, n) > pattern_llc_bytes();
+}
+
+/**
+ * Formats a whole pattern into memory (the buffer and mmap sinks)
+ *
+ * Output larger than the last-level cache is written with non-temporal
+ * stores under PATTERN_STREAM_AUTO: it cannot stay cached anyway, and
+ * normal stores would read every line in first and push out whatever
+ * else the process had cached. The masters stay cached either way, as
+ * they are only read. The masters must already cover n.
+ *
+ * @param dst pattern_total_bytes(shape, n) bytes
+ */
+static inline void pattern_render_buffer(const pattern_ctx *ctx, int shape,
+                                         size_t n, char *dst) {
+    int stream = pattern_stream_wanted(ctx, shape, n);
+    for (size_t k = 0; k < pattern_rows(shape, n); k++) {
+        dst += pattern_render_row(ctx, shape, n, k, dst, stream);
+    }
+    if (stream) {
+        pattern_stream_fence();
+    }
+}
+
+/**
+ * Pool task: formats chunk `index` of a segment
+ */
+static inline void pattern_segment_run(void *arg, size_t index,
+                                       int worker) {
+    pattern_segment *seg = arg;
+    pattern_pool *pool = seg->pool;
+    (void)worker;
+    char *at = seg->buf + seg->offset[index];
+    for (size_t k = seg->first[index]; k < seg->first[index + 1]; k++) {
+        at += pattern_render_row(seg->ctx, seg->shape, seg->n, k, at, 0);
+    }
+    // The slot may be reused as soon as the count reaches zero
+    if (__atomic_sub_fetch(&seg->pending, 1, __ATOMIC_SEQ_CST) == 0) {
+        pattern_pool_done(pool);
+    }
+}
+
+/**
+ * Makes sure a slot's buffer holds `bytes`
+ *
+ * @return 0 on success, -1 if memory could not be mapped
+ */
+static inline int pattern_segment_reserve(pattern_segment *seg,
+                                          size_t bytes) {
+    if (seg->cap >= bytes) {
+        return 0;
+    }
+    size_t cap = pattern_page_round(bytes > PATTERN_SEGMENT_BYTES
+                                        ? bytes
+                                        : PATTERN_SEGMENT_BYTES);
+    char *buf = pattern_map(cap);
+    if (buf == NULL) {
+        return -1;
+    }
+    pattern_unmap(seg->buf, seg->cap);
+    seg->buf = buf;
+    seg->cap = cap;
+    return 0;
+}
+
+/**
+ * Writes out the oldest slot, first helping with its chunks until they
+ * are all formatted
+ *
+ * The buffer is reused for later slots, except in splice mode: the pipe
+ * may still point at its pages, so it is unmapped (the pipe keeps its
+ * references) and the slot maps a fresh one.
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int pattern_reorder_retire(pattern_ctx *ctx) {
+    pattern_reorder *ro = &ctx->order;
+    pattern_segment *seg = &ro->slot[ro->head % ro->depth];
+    pattern_pool_help(&ctx->pool, &seg->pending);
+
+    int status = pattern_writer_ref(&ctx->out, seg->buf, seg->bytes) == 0 &&
+                         pattern_writer_flush(&ctx->out) == 0
+                     ? 0
+                     : -1;
+    if (ctx->out.sink == PATTERN_SINK_SPLICE) {
+        pattern_unmap(seg->buf, seg->cap);
+        seg->buf = NULL;
+        seg->cap = 0;
+    }
+    ro->head++;
+    return status;
+}
+
+/**
+ * Writes out finished slots, oldest first, stopping at the first that
+ * still has chunks to format; with `wait`, writes out every slot
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int pattern_reorder_emit(pattern_ctx *ctx, int wait) {
+    pattern_reorder *ro = &ctx->order;
+    int status = 0;
+    while (ro->head < ro->tail) {
+        pattern_segment *seg = &ro->slot[ro->head % ro->depth];
+        if (!wait && __atomic_load_n(&seg->pending, __ATOMIC_ACQUIRE) > 0) {
+            break;
+        }
+        if (pattern_reorder_retire(ctx) != 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/**
+ * Takes the next free slot, writing out the oldest one if the reorder
+ * buffer is as deep as the pool allows
+ *
+ * @return Slot, not yet counted in [head, tail), or NULL on a write
+ *         error
+ */
+static inline pattern_segment *pattern_reorder_claim(pattern_ctx *ctx) {
+    pattern_reorder *ro = &ctx->order;
+    if (ro->tail - ro->head == ro->depth &&
+        pattern_reorder_retire(ctx) != 0) {
+        return NULL;
+    }
+    pattern_segment *seg = &ro->slot[ro->tail % ro->depth];
+    seg->ctx = ctx;
+    seg->pool = &ctx->pool;
+    seg->shape = -1;
+    seg->bytes = 0;
+    seg->pending = 0;
+    seg->chunks = 0;
+    return seg;
+}
+
+/**
+ * Space for `len` bytes of output formatted by the calling thread but
+ * queued behind the slots in flight: at the end of the newest slot if
+ * that is an inline one with room, else in a new slot
+ *
+ * @return Where to write them, or NULL on a write or mapping error
+ */
+static inline char *pattern_reorder_inline(pattern_ctx *ctx, size_t len) {
+    pattern_reorder *ro = &ctx->order;
+    if (ro->tail > ro->head) {
+        pattern_segment *last =
+            &ro->slot[(ro->tail - 1) % ro->depth];
+        if (last->shape < 0 && last->cap - last->bytes >= len) {
+            last->bytes += len;
+            return last->buf + last->bytes - len;
+        }
+    }
+    pattern_segment *seg = pattern_reorder_claim(ctx);
+    if (seg == NULL) {
+        return NULL;
+    }
+    if (pattern_segment_reserve(seg, len) != 0) {
+        ctx->out.error = ENOMEM;
+        return NULL;
+    }
+    seg->bytes = len;
+    ro->tail++;
+    return seg->buf;
+}
+
+/**
+ * Writes out everything in flight, then flushes the writer
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int pattern_ctx_flush(pattern_ctx *ctx) {
+    int status = pattern_reorder_emit(ctx, 1);
+    return pattern_writer_flush(&ctx->out) == 0 ? status : -1;
+}
+
+/**
+ * Writes out everything in flight and releases the context
+ *
+ * @return 0 on success, otherwise the errno of the failed write
+ */
+static inline int pattern_ctx_close(pattern_ctx *ctx) {
+    pattern_reorder_emit(ctx, 1);
+    pattern_writer_close(&ctx->out);
+    pattern_pool_stop(&ctx->pool);
+    for (int s = 0; s < PATTERN_REORDER_SLOTS; s++) {
+        pattern_segment *seg = &ctx->order.slot[s];
+        pattern_unmap(seg->buf, seg->cap);
+    }
+    triangle_master_free(&ctx->tri);
+    concentric_master_free(&ctx->con);
+    return ctx->out.error;
+}
+
+/**
+ * Queues a copy of `len` bytes (a frame header), in order with the
+ * renders in flight
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_ctx_copy(pattern_ctx *ctx, const char *p,
+                                   size_t len) {
+    if (ctx->order.head == ctx->order.tail) {
+        return pattern_writer_copy(&ctx->out, p, len);
+    }
+    char *at = pattern_reorder_inline(ctx, len);
+    if (at == NULL) {
+        return -1;
+    }
+    memcpy(at, p, len);
+    return 0;
+}
+
+/**
+ * Makes sure the master for a shape covers n
+ *
+ * A master that has to grow is replaced and the old one unmapped, so
+ * everything in flight is finished and written out first: pool tasks may
+ * still be reading the old master, and queued output may point into it.
+ *
+ * @return 0 on success, -1 on a write error or if memory could not be
+ *         mapped (ctx->out.error is set either way)
+ */
+static inline int pattern_ctx_reserve(pattern_ctx *ctx, int shape, size_t n) {
+    size_t covered = shape == PATTERN_TRIANGLE ? ctx->tri.n : ctx->con.n;
+    if (n > covered && pattern_ctx_flush(ctx) != 0) {
+        return -1;
+    }
+    int mapped = shape == PATTERN_TRIANGLE
+                     ? triangle_master_reserve(&ctx->tri, n)
+                     : concentric_master_reserve(&ctx->con, n);
+    if (mapped != 0) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Splits rows [start, end), `bytes` long in total, into `workers`
+ * contiguous slices of roughly equal bytes: slice t is rows
+ * [first[t], first[t+1]) at byte offset[t] from the first row. Rows are
+ * never split, so rows longer than a share leave some slices empty.
+ */
+static inline void pattern_split_rows(int shape, size_t n, size_t start,
+                                      size_t end, size_t bytes, int workers,
+                                      size_t *first, size_t *offset) {
+    size_t share = bytes / (size_t)workers + 1;
+    size_t row = start;
+    size_t at = 0;
+    for (int t = 0; t < workers; t++) {
+        first[t] = row;
+        offset[t] = at;
+        size_t slice = 0;
+        while (row < end && (slice < share || t == workers - 1)) {
+            slice += pattern_row_bytes(shape, n, row++);
+        }
+        at += slice;
+    }
+    first[workers] = end;
+    offset[workers] = at;
+}
+
+/**
+ * Queues a large pattern on the pool as segments of stealable chunks
+ *
+ * The calling thread only cuts the rows into chunks of about
+ * PATTERN_CHUNK_BYTES, deals them round-robin to every worker's deque
+ * and returns; it does not wait for them, and works through its own
+ * share whenever it has to wait for a slot. Idle workers steal from busy
+ * ones, so chunks of uneven cost (a concentric row grows with n, a triangle
+ * row with its index) never leave a core idle behind a static split.
+ * Each segment is written out in order once its chunks are done, by a
+ * later call that needs its slot or by pattern_ctx_flush(). A single
+ * row is never split, so a row longer than a chunk is a chunk of its
+ * own.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render_chunked(pattern_ctx *ctx, int shape,
+                                         size_t n) {
+    pattern_reorder *ro = &ctx->order;
+    size_t rows = pattern_rows(shape, n);
+    size_t k = 0;
+    while (k < rows) {
+        pattern_segment *seg = pattern_reorder_claim(ctx);
+        if (seg == NULL) {
+            return -1;
+        }
+
+        // Rows up to the segment size, closing a chunk every
+        // PATTERN_CHUNK_BYTES
+        size_t bytes = 0;
+        size_t chunk = 0;
+        int c = 0;
+        seg->first[0] = k;
+        seg->offset[0] = 0;
+        while (k < rows && bytes < PATTERN_SEGMENT_BYTES) {
+            size_t row = pattern_row_bytes(shape, n, k++);
+            bytes += row;
+            chunk += row;
+            if (k == rows || bytes >= PATTERN_SEGMENT_BYTES ||
+                (chunk >= PATTERN_CHUNK_BYTES &&
+                 c < PATTERN_SEGMENT_CHUNKS - 1)) {
+                c++;
+                seg->first[c] = k;
+                seg->offset[c] = bytes;
+                chunk = 0;
+            }
+        }
+        if (pattern_segment_reserve(seg, bytes) != 0) {
+            ctx->out.error = ENOMEM;
+            return -1;
+        }
+        seg->shape = shape;
+        seg->n = n;
+        seg->bytes = bytes;
+        seg->chunks = c;
+        seg->pending = c;
+        ro->tail++;
+
+        for (int i = 0; i < c; i++) {
+            pattern_task task = {pattern_segment_run, seg, (size_t)i};
+            int worker = (int)(ro->next++ % (unsigned)ctx->pool.count);
+            if (pattern_pool_push(&ctx->pool, worker, task) != 0) {
+                pattern_segment_run(seg, (size_t)i, 0);
+            }
+        }
+        pattern_pool_wake(&ctx->pool);
+        if (pattern_reorder_emit(ctx, 0) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Renders one pattern into the context's writer
+ *
+ * Large patterns are queued on the thread pool when it has more than one
+ * worker (pattern_render_chunked) and may still be in flight on return.
+ * Small ones stay on the calling thread: emitted as references into the
+ * masters, or, while large ones are in flight, formatted into the
+ * reorder buffer behind them, so output always keeps request order.
+ * pattern_ctx_flush() waits for everything.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render(pattern_ctx *ctx, int shape, size_t n) {
+    size_t bytes = (size_t)pattern_total_bytes(shape, n);
+    if (ctx->pool.count > 1 && bytes >= ctx->parallel_min) {
+        if (pattern_ctx_reserve(ctx, shape, n) != 0) {
+            return -1;
+        }
+        return pattern_render_chunked(ctx, shape, n);
+    }
+    if (ctx->order.head < ctx->order.tail) {
+        // Reserving may finish everything in flight; check again after
+        if (pattern_ctx_reserve(ctx, shape, n) != 0) {
+            return -1;
+        }
+    }
+    if (ctx->order.head < ctx->order.tail) {
+        char *dst = pattern_reorder_inline(ctx, bytes);
+        if (dst == NULL) {
+            return -1;
+        }
+        pattern_render_buffer(ctx, shape, n, dst);
+        return pattern_reorder_emit(ctx, 0);
+    }
+    if (shape == PATTERN_TRIANGLE) {
+        return triangle_write(&ctx->out, &ctx->tri, n);
+    }
+    return concentric_write(&ctx->out, &ctx->con, n);
+}
+
+/**
+ * Renders a triangle variant (TRIANGLE_*) into the context's writer
+ *
+ * The left triangle is pattern_render(). The other variants are slices
+ * of the same master (triangle_variant_write), queued on the calling
+ * thread: there is nothing to format, so nothing to hand to the pool.
+ * While renders are in flight, the slices are copied into the reorder
+ * buffer behind them instead.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render_triangle(pattern_ctx *ctx, int variant,
+                                          size_t n) {
+    if (variant == TRIANGLE_LEFT) {
+        return pattern_render(ctx, PATTERN_TRIANGLE, n);
+    }
+    if (pattern_ctx_reserve(ctx, PATTERN_TRIANGLE, n) != 0) {
+        return -1;
+    }
+    if (ctx->order.head < ctx->order.tail) {
+        size_t bytes = (size_t)triangle_variant_total_bytes(variant, n);
+        char *dst = pattern_reorder_inline(ctx, bytes);
+        if (dst == NULL) {
+            return -1;
+        }
+        triangle_variant_copy(&ctx->tri, variant, n, dst);
+        return pattern_reorder_emit(ctx, 0);
+    }
+    return triangle_variant_write(&ctx->out, &ctx->tri, variant, n);
+}
+
+/**
+ * Binds every pool worker to a CPU, node by node (pattern_numa_place)
+ *
+ * Worker t renders the t-th row slice of a spread render, so with the
+ * workers pinned, each node's slices are formatted, and first touched,
+ * by that node's CPUs. Worker 0 is the calling thread, which is pinned
+ * too.
+ *
+ * @return 0 on success, otherwise the errno of the first failed pin
+ */
+static inline int pattern_ctx_pin(pattern_ctx *ctx) {
+    pattern_numa numa;
+    pattern_numa_load(&numa);
+    int error = 0;
+    for (int t = 0; t < ctx->pool.count; t++) {
+        pthread_t thread = t == 0 ? pthread_self() : ctx->pool.threads[t];
+        int err = pattern_numa_pin(thread,
+                                   pattern_numa_cpu(&numa, t,
+                                                    ctx->pool.count));
+        error = error != 0 ? error : err;
+    }
+    ctx->pinned = error == 0;
+    return error;
+}
+
+/**
+ * One spread render: worker t formats rows [first[t], first[t+1]) at
+ * dst + offset[t]
+ */
+typedef struct pattern_spread_job {
+    pattern_ctx *ctx;
+    int shape;
+    size_t n;
+    char *dst;
+    int stream;
+    int populate;
+    size_t first[PATTERN_MAX_THREADS + 1];
+    size_t offset[PATTERN_MAX_THREADS + 1];
+} pattern_spread_job;
+
+/**
+ * Prefaults the whole pages of one worker's slice
+ *
+ * A page shared with the previous slice is that worker's to touch.
+ */
+static inline void pattern_slice_populate(char *slice, size_t bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t from = ((uintptr_t)slice + page - 1) & ~(uintptr_t)(page - 1);
+    uintptr_t to = ((uintptr_t)slice + bytes) & ~(uintptr_t)(page - 1);
+    if (to > from) {
+        pattern_populate((char *)from, (size_t)(to - from));
+    }
+}
+
+/**
+ * Records what a worker did with its slice: time since `start`, bytes,
+ * and where its pages ended up
+ */
+static inline void pattern_slice_record(pattern_worker_stats *ws,
+                                        const char *slice, size_t bytes,
+                                        unsigned long long start) {
+    ws->ns = pattern_now_ns() - start;
+    ws->bytes = bytes;
+    ws->node = pattern_numa_current();
+    size_t pages = bytes / (size_t)sysconf(_SC_PAGESIZE);
+    ws->sampled = pages < 64 ? (int)pages : 64;
+    ws->local = ws->node >= 0 && ws->sampled > 0
+                    ? pattern_numa_local(slice, bytes, ws->sampled, ws->node)
+                    : -1;
+}
+
+static inline void pattern_spread_run(void *arg, int worker) {
+    pattern_spread_job *job = arg;
+    unsigned long long start = pattern_now_ns();
+    char *slice = job->dst + job->offset[worker];
+    size_t bytes = job->offset[worker + 1] - job->offset[worker];
+
+    if (job->populate) {
+        pattern_slice_populate(slice, bytes);
+    }
+    char *at = slice;
+    for (size_t k = job->first[worker]; k < job->first[worker + 1]; k++) {
+        at += pattern_render_row(job->ctx, job->shape, job->n, k, at,
+                                 job->stream);
+    }
+    if (job->stream) {
+        pattern_stream_fence();
+    }
+    pattern_slice_record(&job->ctx->worker[worker], slice, bytes, start);
+}
+
+/**
+ * Formats a whole pattern into memory on every pool worker
+ *
+ * The pattern is split once into one contiguous row slice per worker,
+ * and each worker formats its slice in place. On a fresh mapping this
+ * makes each worker the first to touch its slice's pages, so with
+ * pattern_ctx_pin() they are allocated on that worker's node and the
+ * render scales with the number of memory controllers rather than
+ * stopping at one socket's bandwidth. With `populate`, each worker
+ * prefaults its own slice for the same reason. Per-worker time, bytes
+ * and page placement are left in ctx->worker[].
+ *
+ * @param dst pattern_total_bytes(shape, n) bytes; the masters must
+ *            cover n
+ */
+static inline void pattern_render_spread(pattern_ctx *ctx, int shape,
+                                         size_t n, char *dst, int populate) {
+    size_t bytes = (size_t)pattern_total_bytes(shape, n);
+    if (ctx->pool.count < 2 || bytes < ctx->parallel_min) {
+        if (populate) {
+            pattern_populate(dst, bytes);
+        }
+        pattern_render_buffer(ctx, shape, n, dst);
+        ctx->spread = 0;
+        return;
+    }
+    pattern_spread_job job;
+    job.ctx = ctx;
+    job.shape = shape;
+    job.n = n;
+    job.dst = dst;
+    job.stream = pattern_stream_wanted(ctx, shape, n);
+    job.populate = populate;
+    pattern_split_rows(shape, n, 0, pattern_rows(shape, n), bytes,
+                       ctx->pool.count, job.first, job.offset);
+    pattern_pool_run(&ctx->pool, pattern_spread_run, &job);
+    ctx->spread = ctx->pool.count;
+}
+
+/**
+ * Buffer sink: renders one pattern into memory, then writes it out
+ *
+ * The whole pattern is formatted by pattern_render_spread() into a
+ * mapping from pattern_map_buffer() (ctx->pages, ctx->populate) and
+ * queued as a single reference. For a large pattern most of the format
+ * time is then page faults, one per 4 KB of output, which is what huge
+ * pages and prefaulting are for. The mapping is dropped after the
+ * flush; a pipe keeps its own references to spliced pages.
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render_memory(pattern_ctx *ctx, int shape,
+                                        size_t n) {
+    size_t bytes = (size_t)pattern_total_bytes(shape, n);
+    size_t size = bytes;
+    if (pattern_ctx_reserve(ctx, shape, n) != 0) {
+        return -1;
+    }
+    ctx->pages_used = ctx->pages;
+    char *buf = pattern_map_buffer(&size, &ctx->pages_used, 0);
+    if (buf == NULL) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+    pattern_render_spread(ctx, shape, n, buf, ctx->populate);
+    int status = pattern_writer_ref(&ctx->out, buf, bytes) == 0 &&
+                         pattern_writer_flush(&ctx->out) == 0
+                     ? 0
+                     : -1;
+    pattern_unmap(buf, size);
+    return status;
+}
+
+/**
+ * Range of the output file mapped by pattern_file_map()
+ */
+typedef struct pattern_file_span {
+    char *map;                  // mapping, from the page below `at`
+    size_t size;                // bytes mapped
+    off_t at;                   // file offset of the range
+    size_t bytes;               // bytes in the range
+} pattern_file_span;
+
+/**
+ * Extends the output file by `bytes` at its current offset and maps the
+ * new range shared, so stores into it land in the page cache with no
+ * write syscall at all
+ *
+ * The output must be a regular file open for reading and writing, and
+ * the writer must have been flushed. Huge pages can only be asked for
+ * (MADV_HUGEPAGE): tmpfs honours that according to its huge= setting,
+ * most disk filesystems ignore it; reserved huge pages need hugetlbfs
+ * and are never used here.
+ *
+ * @return Start of the range, or NULL on error (ctx->out.error is set)
+ */
+static inline char *pattern_file_map(pattern_ctx *ctx, size_t bytes,
+                                     pattern_file_span *span) {
+    pattern_writer *w = &ctx->out;
+    // Extend only: like write(2), never cut off what lies past the end
+    off_t at = lseek(w->fd, 0, SEEK_CUR);
+    struct stat st;
+    if (at < 0 || fstat(w->fd, &st) != 0 ||
+        (st.st_size < at + (off_t)bytes &&
+         ftruncate(w->fd, at + (off_t)bytes) != 0)) {
+        w->error = errno;
+        return NULL;
+    }
+    off_t base = at - at % (off_t)sysconf(_SC_PAGESIZE);
+    span->size = (size_t)(at - base) + bytes;
+    span->map = mmap(NULL, span->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     w->fd, base);
+    if (span->map == MAP_FAILED) {
+        w->error = errno;
+        return NULL;
+    }
+    span->at = at;
+    span->bytes = bytes;
+    // Only the advice is known to have been taken; the fault count of
+    // --stats shows whether the file system acted on it
+    ctx->pages_used = PATTERN_PAGES_SMALL;
+    if (ctx->pages != PATTERN_PAGES_SMALL &&
+        madvise(span->map, span->size, MADV_HUGEPAGE) == 0) {
+        ctx->pages_used = PATTERN_PAGES_THP;
+    }
+    return span->map + (at - base);
+}
+
+/**
+ * Unmaps a range from pattern_file_map() and moves the file offset past
+ * it, as if it had been written
+ *
+ * @return 0 on success, -1 on error (ctx->out.error is set)
+ */
+static inline int pattern_file_unmap(pattern_ctx *ctx,
+                                     const pattern_file_span *span) {
+    pattern_writer *w = &ctx->out;
+    munmap(span->map, span->size);
+    if (lseek(w->fd, span->at + (off_t)span->bytes, SEEK_SET) < 0) {
+        w->error = errno;
+        return -1;
+    }
+    w->bytes += span->bytes;
+    return 0;
+}
+
+/**
+ * Mmap sink: renders one pattern straight into the output file, through
+ * pattern_file_map()
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render_file(pattern_ctx *ctx, int shape,
+                                      size_t n) {
+    size_t bytes = (size_t)pattern_total_bytes(shape, n);
+    pattern_file_span span;
+    // Anything queued (a frame header) goes before the pattern
+    if (pattern_ctx_reserve(ctx, shape, n) != 0 ||
+        pattern_writer_flush(&ctx->out) != 0) {
+        return -1;
+    }
+    char *dst = pattern_file_map(ctx, bytes, &span);
+    if (dst == NULL) {
+        return -1;
+    }
+    pattern_render_spread(ctx, shape, n, dst, ctx->populate);
+    return pattern_file_unmap(ctx, &span);
+}
+
+#endif // PATTERN_RENDER_H
@@ -0,0 +1,757 @@
+/**
+ * pattern_rle.h
+ *
+ * Run-length wire format for both patterns.
+ *
+ * Every row of either pattern is a few runs of tokens followed by a
+ * newline, and from one row to the next each run changes linearly:
+ *
+ *   triangle row r      "* " × r
+ *   square row, p       "n n-1 ... p+1 " | "p " × (2p-1) | "p+1 ... n "
+ *
+ * A message therefore describes a pattern as groups of rows, each group
+ * a list of spans whose token count (and first value, for numbers) is
+ * given for the group's first row plus a change per row. A triangle is
+ * one group of one span, a square two groups of three (the upper half,
+ * plateaus n down to 1, and the lower half, 2 up to n). Any n encodes
+ * in a few dozen bytes; n = 100,000 is 10 GB of triangle text and 280 GB
+ * of square text.
+ *
+ * Message layout; integers are LEB128 varints, and ± marks a zigzag
+ * signed one:
+ *
+ *   "PRLE" u8 version, varint total bytes, varint max value,
+ *   varint groups, then per group:
+ *     varint rows, u8 spans, then per span:
+ *       u8 kind, varint count, ±count per row,
+ *       GLYPH:         u8 token length, token bytes
+ *       FLAT/DOWN/UP:  varint value, ±value per row
+ *
+ * Each row of a group is its spans in order and then '\n'. Messages go
+ * back to back, one per pattern, and the decoder knows nothing about the
+ * shapes: it only expands spans.
+ *
+ * Expansion writes through a pattern_writer like the renderers, and
+ * mostly by reference. A GLYPH token is filled once (pattern_fill, the
+ * vector fill kernels) into a run as long as the longest row needs, and
+ * every row references a prefix of it, as triangle rows reference the
+ * triangle master. DOWN and UP runs reference the ladders of a
+ * concentric_master covering the message's max value. Only FLAT runs,
+ * whose token changes from row to row, are filled per row, as the
+ * concentric renderer fills its plateaus.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_RLE_H
+#define PATTERN_RLE_H
+
+#include "pattern_render.h"
+
+#define PATTERN_RLE_VERSION 1
+
+// Limits on one message, far above what either shape needs
+#define PATTERN_RLE_GROUPS    4
+#define PATTERN_RLE_SPANS     4
+#define PATTERN_RLE_TOKEN_MAX 16
+
+// Longest message within those limits
+#define PATTERN_RLE_MAX 1024
+
+// Glyph runs a decoder keeps formatted across messages
+#define PATTERN_RLE_GLYPHS (PATTERN_RLE_GROUPS * PATTERN_RLE_SPANS)
+
+// Input read at a time by pattern_rle_decode()
+#define PATTERN_RLE_READ (64u << 10)
+
+// Span kinds
+#define PATTERN_RLE_GLYPH 0     // a literal token repeated
+#define PATTERN_RLE_FLAT  1     // the number token "v " repeated
+#define PATTERN_RLE_DOWN  2     // "v v-1 v-2 ... "
+#define PATTERN_RLE_UP    3     // "v v+1 v+2 ... "
+#define PATTERN_RLE_KINDS 4
+
+// pattern_rle_decode() result for input that is not a valid stream
+#define PATTERN_RLE_MALFORMED (-2)
+
+/**
+ * One run of tokens in every row of a group; row r of the group has
+ * count + r·dcount tokens starting at value + r·dvalue
+ */
+typedef struct pattern_rle_span {
+    int kind;
+    long long count;
+    long long dcount;
+    long long value;            // number kinds only
+    long long dvalue;
+    char token[PATTERN_RLE_TOKEN_MAX];     // GLYPH only
+    size_t token_len;
+    const char *run;            // GLYPH: set by pattern_rle_bind()
+} pattern_rle_span;
+
+typedef struct pattern_rle_group {
+    long long rows;
+    int spans;
+    pattern_rle_span span[PATTERN_RLE_SPANS];
+} pattern_rle_group;
+
+/**
+ * A decoded (or to be encoded) message
+ */
+typedef struct pattern_rle {
+    unsigned long long total;   // bytes of text it expands to
+    size_t max;                 // largest number token, 0 if none
+    int groups;
+    pattern_rle_group group[PATTERN_RLE_GROUPS];
+} pattern_rle;
+
+/* ------------------------------------------------------------------ */
+/* Encoding                                                            */
+/* ------------------------------------------------------------------ */
+
+static inline pattern_rle_span *pattern_rle_add(pattern_rle_group *g,
+                                                int kind, long long count,
+                                                long long dcount,
+                                                long long value,
+                                                long long dvalue) {
+    pattern_rle_span *s = &g->span[g->spans++];
+    memset(s, 0, sizeof(*s));
+    s->kind = kind;
+    s->count = count;
+    s->dcount = dcount;
+    s->value = value;
+    s->dvalue = dvalue;
+    return s;
+}
+
+/**
+ * Describes the pattern for n as groups of spans
+ */
+static inline void pattern_rle_describe(pattern_rle *msg, int shape,
+                                        size_t n) {
+    long long m = (long long)n;
+    memset(msg, 0, sizeof(*msg));
+    msg->total = pattern_total_bytes(shape, n);
+
+    if (shape == PATTERN_TRIANGLE) {
+        pattern_rle_group *g = &msg->group[msg->groups++];
+        g->rows = m;
+        pattern_rle_span *s = pattern_rle_add(g, PATTERN_RLE_GLYPH, 1, 1,
+                                              0, 0);
+        memcpy(s->token, "* ", 2);
+        s->token_len = 2;
+        return;
+    }
+
+    // Upper half, row r has plateau p = n - r: n..p+1 | p × (2p-1) |
+    // p+1..n. The outer runs start empty and grow by one token per row.
+    msg->max = n;
+    pattern_rle_group *g = &msg->group[msg->groups++];
+    g->rows = m;
+    pattern_rle_add(g, PATTERN_RLE_DOWN, 0, 1, m, 0);
+    pattern_rle_add(g, PATTERN_RLE_FLAT, 2 * m - 1, -2, m, -1);
+    pattern_rle_add(g, PATTERN_RLE_UP, 0, 1, m + 1, -1);
+
+    // Lower half, plateaus 2..n: the same runs shrinking back
+    if (n > 1) {
+        g = &msg->group[msg->groups++];
+        g->rows = m - 1;
+        pattern_rle_add(g, PATTERN_RLE_DOWN, m - 2, -1, m, 0);
+        pattern_rle_add(g, PATTERN_RLE_FLAT, 3, 2, 2, 1);
+        pattern_rle_add(g, PATTERN_RLE_UP, m - 2, -1, 3, 1);
+    }
+}
+
+static inline size_t pattern_rle_put(unsigned char *dst,
+                                     unsigned long long v) {
+    size_t len = 0;
+    while (v >= 0x80) {
+        dst[len++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    dst[len++] = (unsigned char)v;
+    return len;
+}
+
+static inline size_t pattern_rle_put_signed(unsigned char *dst,
+                                            long long v) {
+    unsigned long long u = (unsigned long long)v;
+    return pattern_rle_put(dst, v < 0 ? ~(u << 1) : u << 1);
+}
+
+/**
+ * Serializes a message
+ *
+ * @param dst PATTERN_RLE_MAX bytes
+ * @return Message length
+ */
+static inline size_t pattern_rle_pack(const pattern_rle *msg, char *dst) {
+    unsigned char *at = (unsigned char *)dst;
+    memcpy(at, "PRLE", 4);
+    at += 4;
+    *at++ = PATTERN_RLE_VERSION;
+    at += pattern_rle_put(at, msg->total);
+    at += pattern_rle_put(at, msg->max);
+    at += pattern_rle_put(at, (unsigned long long)msg->groups);
+    for (int i = 0; i < msg->groups; i++) {
+        const pattern_rle_group *g = &msg->group[i];
+        at += pattern_rle_put(at, (unsigned long long)g->rows);
+        *at++ = (unsigned char)g->spans;
+        for (int j = 0; j < g->spans; j++) {
+            const pattern_rle_span *s = &g->span[j];
+            *at++ = (unsigned char)s->kind;
+            at += pattern_rle_put(at, (unsigned long long)s->count);
+            at += pattern_rle_put_signed(at, s->dcount);
+            if (s->kind == PATTERN_RLE_GLYPH) {
+                *at++ = (unsigned char)s->token_len;
+                memcpy(at, s->token, s->token_len);
+                at += s->token_len;
+            } else {
+                at += pattern_rle_put(at, (unsigned long long)s->value);
+                at += pattern_rle_put_signed(at, s->dvalue);
+            }
+        }
+    }
+    return (size_t)(at - (unsigned char *)dst);
+}
+
+/**
+ * Queues the message for n through the context, in order with the
+ * renders in flight
+ *
+ * @return Message length, or 0 on a write or mapping error
+ */
+static inline size_t pattern_rle_emit(pattern_ctx *ctx, int shape,
+                                      size_t n) {
+    pattern_rle msg;
+    char buf[PATTERN_RLE_MAX];
+    pattern_rle_describe(&msg, shape, n);
+    size_t len = pattern_rle_pack(&msg, buf);
+    return pattern_ctx_copy(ctx, buf, len) == 0 ? len : 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decoding                                                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Read position in a message that may not have arrived in full
+ */
+typedef struct pattern_rle_cursor {
+    const unsigned char *at;
+    const unsigned char *end;
+    int state;                  // 0, or 1 when short, -1 when invalid
+} pattern_rle_cursor;
+
+static inline unsigned pattern_rle_byte(pattern_rle_cursor *c) {
+    if (c->at == c->end) {
+        c->state = c->state ? c->state : 1;
+        return 0;
+    }
+    return *c->at++;
+}
+
+static inline unsigned long long pattern_rle_get(pattern_rle_cursor *c) {
+    unsigned long long v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        unsigned b = pattern_rle_byte(c);
+        v |= (unsigned long long)(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            return v;
+        }
+    }
+    c->state = -1;
+    return 0;
+}
+
+static inline long long pattern_rle_get_signed(pattern_rle_cursor *c) {
+    unsigned long long u = pattern_rle_get(c);
+    return (long long)(u >> 1) ^ -(long long)(u & 1);
+}
+
+/**
+ * Token range a number span covers in row r: [*lo, *hi], empty when
+ * *lo > *hi
+ */
+static inline void pattern_rle_values(const pattern_rle_span *s,
+                                      long long r, long long *lo,
+                                      long long *hi) {
+    long long count = s->count + r * s->dcount;
+    long long value = s->value + r * s->dvalue;
+    if (s->kind == PATTERN_RLE_DOWN) {
+        *lo = value - count + 1;
+        *hi = value;
+    } else if (s->kind == PATTERN_RLE_UP) {
+        *lo = value;
+        *hi = value + count - 1;
+    } else {
+        *lo = value;
+        *hi = count > 0 ? value : value - 1;
+    }
+}
+
+/**
+ * Bytes a span expands to in row r of its group
+ */
+static inline unsigned long long pattern_rle_span_bytes(
+        const pattern_rle_span *s, long long r) {
+    unsigned long long count = (unsigned long long)(s->count +
+                                                    r * s->dcount);
+    if (s->kind == PATTERN_RLE_GLYPH) {
+        return count * s->token_len;
+    }
+    if (s->kind == PATTERN_RLE_FLAT) {
+        unsigned long long v = (unsigned long long)(s->value +
+                                                    r * s->dvalue);
+        return count == 0 ? 0 : count * (concentric_digits(v) + 1);
+    }
+    long long lo, hi;
+    pattern_rle_values(s, r, &lo, &hi);
+    return concentric_ladder_bytes((unsigned long long)hi) -
+           concentric_ladder_bytes((unsigned long long)lo - 1);
+}
+
+/**
+ * Checks that every row of a group stays in range
+ *
+ * Counts and token ranges change linearly with the row, so checking the
+ * first and last rows covers all of them.
+ */
+static inline int pattern_rle_group_valid(const pattern_rle_group *g,
+                                          size_t max) {
+    long long limit = 2 * (long long)PATTERN_MAX_N;
+    for (int j = 0; j < g->spans; j++) {
+        const pattern_rle_span *s = &g->span[j];
+        if (s->dcount < -limit || s->dcount > limit ||
+            s->dvalue < -limit || s->dvalue > limit) {
+            return 0;
+        }
+        long long ends[2] = {0, g->rows - 1};
+        for (int e = 0; e < 2 && g->rows > 0; e++) {
+            long long count = s->count + ends[e] * s->dcount;
+            long long lo, hi;
+            pattern_rle_values(s, ends[e], &lo, &hi);
+            if (count < 0 || count > limit ||
+                (s->kind != PATTERN_RLE_GLYPH &&
+                 (lo < 1 || hi > (long long)max))) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Reads one message from the front of src
+ *
+ * @return Its length, 0 if src holds only part of it, or
+ *         PATTERN_RLE_MALFORMED if it is not a valid message
+ */
+static inline long pattern_rle_parse(pattern_rle *msg, const char *src,
+                                     size_t len) {
+    pattern_rle_cursor c = {(const unsigned char *)src,
+                            (const unsigned char *)src + len, 0};
+    memset(msg, 0, sizeof(*msg));
+    for (int k = 0; k < 4; k++) {
+        if (pattern_rle_byte(&c) != (unsigned char)"PRLE"[k] && !c.state) {
+            return PATTERN_RLE_MALFORMED;
+        }
+    }
+    if (pattern_rle_byte(&c) != PATTERN_RLE_VERSION && !c.state) {
+        return PATTERN_RLE_MALFORMED;
+    }
+    msg->total = pattern_rle_get(&c);
+    unsigned long long max = pattern_rle_get(&c);
+    unsigned long long groups = pattern_rle_get(&c);
+    if (max > PATTERN_MAX_N || groups > PATTERN_RLE_GROUPS) {
+        return c.state == 1 ? 0 : PATTERN_RLE_MALFORMED;
+    }
+    msg->max = (size_t)max;
+    msg->groups = (int)groups;
+
+    for (int i = 0; i < msg->groups && !c.state; i++) {
+        pattern_rle_group *g = &msg->group[i];
+        unsigned long long rows = pattern_rle_get(&c);
+        unsigned spans = pattern_rle_byte(&c);
+        if (rows > 2 * PATTERN_MAX_N || spans > PATTERN_RLE_SPANS) {
+            c.state = c.state ? c.state : -1;
+            break;
+        }
+        g->rows = (long long)rows;
+        for (unsigned j = 0; j < spans && !c.state; j++) {
+            pattern_rle_span *s = &g->span[g->spans++];
+            s->kind = (int)pattern_rle_byte(&c);
+            unsigned long long count = pattern_rle_get(&c);
+            s->dcount = pattern_rle_get_signed(&c);
+            if (s->kind == PATTERN_RLE_GLYPH) {
+                s->token_len = pattern_rle_byte(&c);
+                if (s->token_len == 0 ||
+                    s->token_len > PATTERN_RLE_TOKEN_MAX) {
+                    c.state = c.state ? c.state : -1;
+                }
+                for (size_t t = 0; t < s->token_len && !c.state; t++) {
+                    s->token[t] = (char)pattern_rle_byte(&c);
+                }
+            } else {
+                unsigned long long value = pattern_rle_get(&c);
+                s->dvalue = pattern_rle_get_signed(&c);
+                if (value > PATTERN_MAX_N + 1) {
+                    c.state = c.state ? c.state : -1;
+                }
+                s->value = (long long)value;
+            }
+            if (s->kind >= PATTERN_RLE_KINDS || count > 2 * PATTERN_MAX_N) {
+                c.state = c.state ? c.state : -1;
+            }
+            s->count = (long long)count;
+        }
+        if (!c.state && !pattern_rle_group_valid(g, msg->max)) {
+            c.state = -1;
+        }
+    }
+    if (c.state) {
+        return c.state == 1 ? 0 : PATTERN_RLE_MALFORMED;
+    }
+
+    // The declared size must match what the spans expand to
+    unsigned long long total = 0;
+    for (int i = 0; i < msg->groups; i++) {
+        const pattern_rle_group *g = &msg->group[i];
+        for (long long r = 0; r < g->rows; r++) {
+            total += 1;
+            for (int j = 0; j < g->spans; j++) {
+                total += pattern_rle_span_bytes(&g->span[j], r);
+            }
+        }
+    }
+    if (total != msg->total) {
+        return PATTERN_RLE_MALFORMED;
+    }
+    return (long)(c.at - (const unsigned char *)src);
+}
+
+/**
+ * A glyph token repeated `count` times, in its own mapping
+ */
+typedef struct pattern_rle_glyph {
+    char token[PATTERN_RLE_TOKEN_MAX];
+    size_t token_len;
+    char *run;
+    size_t count;
+    size_t map_size;
+} pattern_rle_glyph;
+
+/**
+ * Glyph runs kept across messages; a run that has to grow, or whose
+ * slot is taken by another token, is replaced by a fresh mapping after
+ * the writer is flushed, never rewritten in place (see the vmsplice
+ * lifetime rules in pattern_io.h)
+ */
+typedef struct pattern_rle_glyphs {
+    pattern_rle_glyph slot[PATTERN_RLE_GLYPHS];
+    unsigned next;              // slot replaced when none matches
+} pattern_rle_glyphs;
+
+static inline void pattern_rle_glyphs_free(pattern_rle_glyphs *gs) {
+    for (int i = 0; i < PATTERN_RLE_GLYPHS; i++) {
+        pattern_unmap(gs->slot[i].run, gs->slot[i].map_size);
+    }
+    memset(gs, 0, sizeof(*gs));
+}
+
+/**
+ * Most tokens any row of the message has in a run of this glyph
+ */
+static inline size_t pattern_rle_glyph_need(const pattern_rle *msg,
+                                            const pattern_rle_span *glyph) {
+    long long need = 0;
+    for (int i = 0; i < msg->groups; i++) {
+        const pattern_rle_group *g = &msg->group[i];
+        for (int j = 0; j < g->spans && g->rows > 0; j++) {
+            const pattern_rle_span *s = &g->span[j];
+            if (s->kind != PATTERN_RLE_GLYPH ||
+                s->token_len != glyph->token_len ||
+                memcmp(s->token, glyph->token, s->token_len) != 0) {
+                continue;
+            }
+            long long last = s->count + (g->rows - 1) * s->dcount;
+            need = s->count > need ? s->count : need;
+            need = last > need ? last : need;
+        }
+    }
+    return (size_t)need;
+}
+
+/**
+ * Points every GLYPH span of a parsed message at a run long enough for
+ * all of its rows, formatting the runs that are missing or too short
+ *
+ * @return 0 on success, -1 on a write error or if memory could not be
+ *         mapped (w->error is set either way)
+ */
+static inline int pattern_rle_bind(pattern_writer *w,
+                                   pattern_rle_glyphs *gs,
+                                   pattern_rle *msg) {
+    for (int i = 0; i < msg->groups; i++) {
+        pattern_rle_group *g = &msg->group[i];
+        for (int j = 0; j < g->spans; j++) {
+            pattern_rle_span *s = &g->span[j];
+            size_t need = s->kind == PATTERN_RLE_GLYPH
+                              ? pattern_rle_glyph_need(msg, s)
+                              : 0;
+            if (need == 0) {
+                continue;
+            }
+
+            pattern_rle_glyph *slot = NULL;
+            for (int k = 0; k < PATTERN_RLE_GLYPHS && slot == NULL; k++) {
+                pattern_rle_glyph *at = &gs->slot[k];
+                if (at->token_len == s->token_len &&
+                    memcmp(at->token, s->token, s->token_len) == 0) {
+                    slot = at;
+                }
+            }
+            if (slot == NULL) {
+                slot = &gs->slot[gs->next++ % PATTERN_RLE_GLYPHS];
+            }
+            if (slot->token_len != s->token_len ||
+                memcmp(slot->token, s->token, s->token_len) != 0 ||
+                slot->count < need) {
+                // Queued rows may still point into the run replaced here
+                if (slot->run != NULL && pattern_writer_flush(w) != 0) {
+                    return -1;
+                }
+                pattern_unmap(slot->run, slot->map_size);
+                memset(slot, 0, sizeof(*slot));
+                size_t map_size = pattern_page_round(need * s->token_len);
+                slot->run = pattern_map(map_size);
+                if (slot->run == NULL) {
+                    w->error = ENOMEM;
+                    return -1;
+                }
+                pattern_fill(slot->run, s->token, s->token_len,
+                             need * s->token_len);
+                memcpy(slot->token, s->token, s->token_len);
+                slot->token_len = s->token_len;
+                slot->count = need;
+                slot->map_size = map_size;
+            }
+            s->run = slot->run;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Emits one span of row r
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int pattern_rle_write_span(pattern_writer *w,
+                                         const concentric_master *cm,
+                                         const pattern_rle_span *s,
+                                         long long r) {
+    size_t count = (size_t)(s->count + r * s->dcount);
+    if (count == 0) {
+        return 0;
+    }
+    if (s->kind == PATTERN_RLE_GLYPH) {
+        return pattern_writer_ref(w, s->run, count * s->token_len);
+    }
+    if (s->kind == PATTERN_RLE_FLAT) {
+        char token[24];
+        size_t token_len = concentric_format_token(
+            token, (unsigned long long)(s->value + r * s->dvalue));
+        char *dst = pattern_writer_reserve(w, token_len * count);
+        if (dst == NULL) {
+            return -1;
+        }
+        pattern_fill(dst, token, token_len, token_len * count);
+        return pattern_writer_commit(w, token_len * count);
+    }
+
+    long long lo, hi;
+    pattern_rle_values(s, r, &lo, &hi);
+    size_t below = (size_t)concentric_ladder_bytes((unsigned long long)lo -
+                                                   1);
+    size_t upto = (size_t)concentric_ladder_bytes((unsigned long long)hi);
+    const char *run = s->kind == PATTERN_RLE_UP ? cm->asc + below
+                                                : cm->desc + cm->ladder - upto;
+    return pattern_writer_ref(w, run, upto - below);
+}
+
+/**
+ * Expands a parsed message through the writer; the ladders must cover
+ * msg->max and its glyph spans must be bound (pattern_rle_bind)
+ *
+ * @return 0 on success, -1 on a write error
+ */
+static inline int pattern_rle_write(pattern_writer *w,
+                                    const concentric_master *cm,
+                                    const pattern_rle *msg) {
+    for (int i = 0; i < msg->groups; i++) {
+        const pattern_rle_group *g = &msg->group[i];
+        for (long long r = 0; r < g->rows; r++) {
+            for (int j = 0; j < g->spans; j++) {
+                if (pattern_rle_write_span(w, cm, &g->span[j], r) != 0) {
+                    return -1;
+                }
+            }
+            if (pattern_writer_copy(w, "\n", 1) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Expands every message read from fd, until end of input, through the
+ * context's writer
+ *
+ * Each message is checked in full before any of its text is written, so
+ * a malformed one produces no output.
+ *
+ * @return 0 at end of input, -1 on a write or mapping error,
+ *         PATTERN_RLE_MALFORMED on invalid or unreadable input
+ */
+static inline int pattern_rle_decode(pattern_ctx *ctx, int fd) {
+    pattern_rle_glyphs glyphs = {0};
+    char *buf = malloc(PATTERN_RLE_READ);
+    size_t used = 0;
+    int status = 0;
+    int more = 1;
+    if (buf == NULL) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+
+    while (status == 0 && (more || used > 0)) {
+        if (more) {
+            ssize_t got = read(fd, buf + used, PATTERN_RLE_READ - used);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got < 0) {
+                status = PATTERN_RLE_MALFORMED;
+                break;
+            }
+            more = got > 0;
+            used += (size_t)got;
+        }
+
+        size_t at = 0;
+        pattern_rle msg;
+        long len;
+        while (status == 0 &&
+               (len = pattern_rle_parse(&msg, buf + at, used - at)) != 0) {
+            if (len < 0) {
+                status = PATTERN_RLE_MALFORMED;
+            } else if ((msg.max > 0 &&
+                        pattern_ctx_reserve(ctx, PATTERN_CONCENTRIC,
+                                            msg.max) != 0) ||
+                       pattern_rle_bind(&ctx->out, &glyphs, &msg) != 0 ||
+                       pattern_rle_write(&ctx->out, &ctx->con, &msg) != 0) {
+                status = -1;
+            } else {
+                at += (size_t)len;
+            }
+        }
+        memmove(buf, buf + at, used - at);
+        used -= at;
+        if (!more && used > 0 && status == 0) {
+            status = PATTERN_RLE_MALFORMED;     // a message cut short
+        }
+    }
+    free(buf);
+
+    // Queued rows point into the glyph runs
+    if (pattern_ctx_flush(ctx) != 0 && status == 0) {
+        status = -1;
+    }
+    pattern_rle_glyphs_free(&glyphs);
+    return status;
+}
+
+/**
+ * Checks encoding and expansion against the renderers for both shapes
+ * and a range of n crossing digit-decades, and that every proper prefix
+ * of a message parses as incomplete
+ *
+ * @return 0 if all of them match, -1 otherwise
+ */
+static inline int pattern_rle_check(void) {
+    static const size_t sizes[] = {1, 2, 3, 9, 10, 11, 57, 99, 100, 101,
+                                   1000};
+    int want_fd = memfd_create("pattern_rle_want", 0);
+    int got_fd = memfd_create("pattern_rle_got", 0);
+    char *want = NULL;
+    char *got = NULL;
+    int status = want_fd < 0 || got_fd < 0 ? -1 : 0;
+    triangle_master tm = {0};
+    concentric_master cm = {0};
+    pattern_rle_glyphs glyphs = {0};
+
+    for (int shape = 0; shape < PATTERN_SHAPES && status == 0; shape++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            size_t n = sizes[i];
+            pattern_rle msg;
+            char packed[PATTERN_RLE_MAX];
+            pattern_rle_describe(&msg, shape, n);
+            size_t len = pattern_rle_pack(&msg, packed);
+            for (size_t cut = 0; cut < len && status == 0; cut++) {
+                status = pattern_rle_parse(&msg, packed, cut) == 0 ? 0 : -1;
+            }
+            if (status != 0 ||
+                pattern_rle_parse(&msg, packed, len) != (long)len) {
+                status = -1;
+                break;
+            }
+
+            pattern_writer ww, gw;
+            size_t bytes = (size_t)msg.total;
+            int written =
+                ftruncate(want_fd, 0) == 0 && ftruncate(got_fd, 0) == 0 &&
+                lseek(want_fd, 0, SEEK_SET) == 0 &&
+                lseek(got_fd, 0, SEEK_SET) == 0 &&
+                pattern_writer_init(&ww, want_fd, PATTERN_SINK_WRITEV) == 0 &&
+                pattern_writer_init(&gw, got_fd, PATTERN_SINK_WRITEV) == 0 &&
+                concentric_master_reserve(&cm, n) == 0 &&
+                (shape == PATTERN_TRIANGLE
+                     ? triangle_write(&ww, &tm, n)
+                     : concentric_write(&ww, &cm, n)) == 0 &&
+                pattern_rle_bind(&gw, &glyphs, &msg) == 0 &&
+                pattern_rle_write(&gw, &cm, &msg) == 0;
+            written &= pattern_writer_close(&ww) == 0;
+            written &= pattern_writer_close(&gw) == 0;
+            free(want);
+            free(got);
+            want = malloc(bytes + 1);
+            got = malloc(bytes + 1);
+            if (!written || want == NULL || got == NULL ||
+                pread(want_fd, want, bytes + 1, 0) != (ssize_t)bytes ||
+                pread(got_fd, got, bytes + 1, 0) != (ssize_t)bytes ||
+                memcmp(want, got, bytes) != 0) {
+                status = -1;
+                break;
+            }
+        }
+    }
+
+    free(want);
+    free(got);
+    triangle_master_free(&tm);
+    concentric_master_free(&cm);
+    pattern_rle_glyphs_free(&glyphs);
+    if (want_fd >= 0) {
+        close(want_fd);
+    }
+    if (got_fd >= 0) {
+        close(got_fd);
+    }
+    return status;
+}
+
+#endif // PATTERN_RLE_H
@@ -0,0 +1,487 @@
+/**
+ * pattern_simd.h
+ *
+ * Instruction-set dispatch for the vectorized kernels.
+ *
+ * One binary runs on SSE4.2, AVX2 and AVX-512 machines alike. Every
+ * kernel is compiled once per instruction set with a function-level
+ * target attribute, and an array of variants is indexed by the ISA
+ * picked once at startup:
+ *
+ *   PATTERN_ISA_SCALAR   plain C, the reference every variant must match
+ *   PATTERN_ISA_SSE42    16-byte vectors
+ *   PATTERN_ISA_AVX2     32-byte vectors
+ *   PATTERN_ISA_AVX512   64-byte vectors (AVX-512F)
+ *
+ * The best ISA the CPU reports through cpuid is chosen, unless the
+ * environment variable PATTERN_ISA names a lower one (scalar, sse4.2,
+ * avx2, avx512), which is how tests pin a variant. A request above what
+ * the CPU supports is lowered to the best supported ISA rather than
+ * crashing on an illegal instruction. GNU ifunc would pick the variant
+ * at load time instead, but resolvers run before the environment can be
+ * read safely, so the choice is made lazily on first use.
+ *
+ * This file holds the glyph-fill kernel (repeating a formatted token),
+ * the streaming copy for outputs larger than the last-level cache, and
+ * the narrowing store of the binary matrix export (pattern_matrix.h).
+ * The concentric value kernel lives with the rest of that pattern in
+ * pattern_concentric.h, and pattern_kernels_check() in pattern_render.h
+ * compares every variant with the scalar one.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_SIMD_H
+#define PATTERN_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PATTERN_SIMD_X86 1
+#else
+#define PATTERN_SIMD_X86 0
+#endif
+
+// Instruction sets, from the baseline up
+#define PATTERN_ISA_SCALAR 0
+#define PATTERN_ISA_SSE42  1
+#define PATTERN_ISA_AVX2   2
+#define PATTERN_ISA_AVX512 3
+#define PATTERN_ISAS       4
+
+static const char *const pattern_isa_names[PATTERN_ISAS] = {
+    "scalar",
+    "sse4.2",
+    "avx2",
+    "avx512",
+};
+
+/**
+ * Best instruction set this CPU (and OS) supports
+ */
+static inline int pattern_isa_detect(void) {
+#if PATTERN_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return PATTERN_ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return PATTERN_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return PATTERN_ISA_SSE42;
+    }
+#endif
+    return PATTERN_ISA_SCALAR;
+}
+
+/**
+ * Looks up an instruction set by name
+ *
+ * @return PATTERN_ISA_*, or -1 if the name is unknown
+ */
+static inline int pattern_isa_parse(const char *name) {
+    for (int isa = 0; isa < PATTERN_ISAS; isa++) {
+        if (strcmp(name, pattern_isa_names[isa]) == 0) {
+            return isa;
+        }
+    }
+    return -1;
+}
+
+// Selected ISA, or -1 before the first kernel call
+static int pattern_isa_selected = -1;
+
+/**
+ * Instruction set the kernels dispatch to
+ *
+ * Detection is idempotent, so threads racing through the first call all
+ * store the same value.
+ */
+static inline int pattern_isa(void) {
+    int isa = __atomic_load_n(&pattern_isa_selected, __ATOMIC_RELAXED);
+    if (isa >= 0) {
+        return isa;
+    }
+    isa = pattern_isa_detect();
+    const char *forced = getenv("PATTERN_ISA");
+    int wanted = forced != NULL ? pattern_isa_parse(forced) : -1;
+    if (wanted >= 0 && wanted < isa) {
+        isa = wanted;
+    }
+    __atomic_store_n(&pattern_isa_selected, isa, __ATOMIC_RELAXED);
+    return isa;
+}
+
+/**
+ * Fills dst[0, len) with a token repeated, the last copy possibly cut
+ * short
+ *
+ * The token is written once and each memcpy then doubles the filled
+ * prefix, so k tokens cost log2(k) calls instead of k. `token` may be
+ * dst itself, when the first token is already formatted in place.
+ */
+static inline void pattern_fill_scalar(char *dst, const char *token,
+                                       size_t token_len, size_t len) {
+    size_t first = token_len < len ? token_len : len;
+    if (token != dst) {
+        memcpy(dst, token, first);
+    }
+    for (size_t filled = first; filled < len; filled *= 2) {
+        size_t chunk = filled < len - filled ? filled : len - filled;
+        memcpy(dst + filled, dst, chunk);
+    }
+}
+
+#if PATTERN_SIMD_X86
+
+/*
+ * Vector variants of pattern_fill_scalar(), for width W:
+ *
+ *   - 1-, 2-, 4- and 8-byte tokens ("* ", "7 ", "123 ") divide W, so the
+ *     token is broadcast into a register and stored in full aligned
+ *     vectors. An aligned store at offset a starts (a mod L) bytes into
+ *     the token, so its vector is reloaded from there once the first
+ *     two unaligned stores have laid the pattern down.
+ *   - other tokens up to W/2 bytes: the first W bytes are filled by
+ *     doubling and that vector is stored every s bytes, s being the
+ *     largest multiple of the token length that fits in W. Stores
+ *     overlap by W - s bytes and each lands on a token boundary. These
+ *     stores are unaligned and often split cache lines, so only the
+ *     first PATTERN_FILL_HEAD vectors are filled this way; the rest is
+ *     doubled from that head, whose memcpy calls store aligned.
+ *   - longer tokens, and fills under two vectors, keep the doubling
+ *     copy.
+ */
+#define PATTERN_FILL_HEAD 16
+
+#define PATTERN_FILL_VECTOR(name, isa, width, vec, load, store,             \
+                            store_aligned, set1_8, set1_16, set1_32,        \
+                            set1_64)                                        \
+    __attribute__((target(isa))) static void name(                          \
+            char *dst, const char *token, size_t token_len, size_t len) {   \
+        if (token_len > (width) / 2 || len < 2 * (width)) {                 \
+            pattern_fill_scalar(dst, token, token_len, len);                \
+            return;                                                         \
+        }                                                                   \
+        vec v;                                                              \
+        if ((token_len & (token_len - 1)) == 0) {                           \
+            if (token_len == 1) {                                           \
+                v = set1_8(token[0]);                                       \
+            } else if (token_len == 2) {                                    \
+                short t;                                                    \
+                memcpy(&t, token, 2);                                       \
+                v = set1_16(t);                                             \
+            } else if (token_len == 4) {                                    \
+                int t;                                                      \
+                memcpy(&t, token, 4);                                       \
+                v = set1_32(t);                                             \
+            } else {                                                        \
+                long long t;                                                \
+                memcpy(&t, token, 8);                                       \
+                v = set1_64(t);                                             \
+            }                                                               \
+            store((vec *)dst, v);                                           \
+            store((vec *)(dst + (width)), v);                               \
+            size_t at = (width) - (size_t)(uintptr_t)dst % (width);         \
+            v = load((const vec *)(dst + at % token_len));                  \
+            for (; at + (width) <= len; at += (width)) {                    \
+                store_aligned((vec *)(dst + at), v);                        \
+            }                                                               \
+            at = len - (width);                                             \
+            store((vec *)(dst + at),                                        \
+                  load((const vec *)(dst + at % token_len)));               \
+            return;                                                         \
+        }                                                                   \
+        pattern_fill_scalar(dst, token, token_len, (width));                \
+        v = load((const vec *)dst);                                         \
+        size_t stride = (width) - (width) % token_len;                      \
+        size_t head = len;                                                  \
+        if (head > PATTERN_FILL_HEAD * (width)) {                           \
+            head = PATTERN_FILL_HEAD * (width) -                            \
+                   PATTERN_FILL_HEAD * (width) % token_len;                 \
+        }                                                                   \
+        size_t at = stride;                                                 \
+        for (; at + (width) <= head; at += stride) {                        \
+            store((vec *)(dst + at), v);                                    \
+        }                                                                   \
+        memmove(dst + at, dst, head - at);                                  \
+        pattern_fill_scalar(dst, dst, head, len);                           \
+    }
+
+PATTERN_FILL_VECTOR(pattern_fill_sse42, "sse4.2", 16, __m128i,
+                    _mm_loadu_si128, _mm_storeu_si128, _mm_store_si128,
+                    _mm_set1_epi8, _mm_set1_epi16, _mm_set1_epi32,
+                    _mm_set1_epi64x)
+PATTERN_FILL_VECTOR(pattern_fill_avx2, "avx2", 32, __m256i,
+                    _mm256_loadu_si256, _mm256_storeu_si256,
+                    _mm256_store_si256, _mm256_set1_epi8, _mm256_set1_epi16,
+                    _mm256_set1_epi32, _mm256_set1_epi64x)
+PATTERN_FILL_VECTOR(pattern_fill_avx512, "avx512f", 64, __m512i,
+                    _mm512_loadu_si512, _mm512_storeu_si512,
+                    _mm512_store_si512, _mm512_set1_epi8, _mm512_set1_epi16,
+                    _mm512_set1_epi32, _mm512_set1_epi64)
+
+#undef PATTERN_FILL_VECTOR
+
+static void (*const pattern_fill_variants[PATTERN_ISAS])(
+        char *, const char *, size_t, size_t) = {
+    pattern_fill_scalar,
+    pattern_fill_sse42,
+    pattern_fill_avx2,
+    pattern_fill_avx512,
+};
+
+#else
+
+static void (*const pattern_fill_variants[PATTERN_ISAS])(
+        char *, const char *, size_t, size_t) = {
+    pattern_fill_scalar,
+    pattern_fill_scalar,
+    pattern_fill_scalar,
+    pattern_fill_scalar,
+};
+
+#endif // PATTERN_SIMD_X86
+
+/**
+ * Size of the last-level cache in bytes
+ *
+ * From sysconf when glibc knows it, else from sysfs (VMs often hide it
+ * from cpuid), else a conservative 8 MB.
+ */
+static inline size_t pattern_llc_bytes(void) {
+    static size_t cached;
+    if (cached != 0) {
+        return cached;
+    }
+    long size = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (size <= 0) {
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    for (int index = 4; size <= 0 && index >= 0; index--) {
+        char path[64];
+        char text[32] = {0};
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        FILE *in = fopen(path, "r");
+        if (in != NULL) {
+            if (fgets(text, sizeof(text), in) != NULL) {
+                char *unit;
+                size = strtol(text, &unit, 10);
+                size *= *unit == 'M' ? 1024 * 1024 : *unit == 'K' ? 1024 : 1;
+            }
+            fclose(in);
+        }
+    }
+    cached = size > 0 ? (size_t)size : (size_t)8 << 20;
+    return cached;
+}
+
+/**
+ * memcpy that bypasses the cache where the ISA allows
+ *
+ * Used for output that is far larger than the last-level cache and is
+ * not read back soon: normal stores would first read each line in,
+ * then evict everything else the process had cached, and the line gets
+ * written back anyway. Non-temporal stores go to memory through the
+ * write-combining buffers instead. The destination's unaligned head and
+ * tail use normal stores. Call pattern_stream_fence() before anything
+ * else may read the destination.
+ */
+static inline void pattern_copy_stream_scalar(char *dst, const char *src,
+                                              size_t len) {
+    memcpy(dst, src, len);
+}
+
+#if PATTERN_SIMD_X86
+
+#define PATTERN_COPY_STREAM(name, isa, width, vec, load, stream)            \
+    __attribute__((target(isa))) static void name(char *dst,                \
+                                                  const char *src,          \
+                                                  size_t len) {             \
+        if (len < 4 * (width)) {                                            \
+            memcpy(dst, src, len);                                          \
+            return;                                                         \
+        }                                                                   \
+        size_t head = -(size_t)(uintptr_t)dst % (width);                    \
+        memcpy(dst, src, head);                                             \
+        size_t at = head;                                                   \
+        for (; at + 4 * (width) <= len; at += 4 * (width)) {                \
+            vec a = load((const vec *)(src + at));                          \
+            vec b = load((const vec *)(src + at + (width)));                \
+            vec c = load((const vec *)(src + at + 2 * (width)));            \
+            vec d = load((const vec *)(src + at + 3 * (width)));            \
+            stream((vec *)(dst + at), a);                                   \
+            stream((vec *)(dst + at + (width)), b);                         \
+            stream((vec *)(dst + at + 2 * (width)), c);                     \
+            stream((vec *)(dst + at + 3 * (width)), d);                     \
+        }                                                                   \
+        memcpy(dst + at, src + at, len - at);                               \
+    }
+
+PATTERN_COPY_STREAM(pattern_copy_stream_sse42, "sse4.2", 16, __m128i,
+                    _mm_loadu_si128, _mm_stream_si128)
+PATTERN_COPY_STREAM(pattern_copy_stream_avx2, "avx2", 32, __m256i,
+                    _mm256_loadu_si256, _mm256_stream_si256)
+PATTERN_COPY_STREAM(pattern_copy_stream_avx512, "avx512f", 64, __m512i,
+                    _mm512_loadu_si512, _mm512_stream_si512)
+
+#undef PATTERN_COPY_STREAM
+
+static void (*const pattern_copy_stream_variants[PATTERN_ISAS])(
+        char *, const char *, size_t) = {
+    pattern_copy_stream_scalar,
+    pattern_copy_stream_sse42,
+    pattern_copy_stream_avx2,
+    pattern_copy_stream_avx512,
+};
+
+/**
+ * Orders non-temporal stores before everything after it
+ */
+static inline void pattern_stream_fence(void) {
+    _mm_sfence();
+}
+
+#else
+
+static void (*const pattern_copy_stream_variants[PATTERN_ISAS])(
+        char *, const char *, size_t) = {
+    pattern_copy_stream_scalar,
+    pattern_copy_stream_scalar,
+    pattern_copy_stream_scalar,
+    pattern_copy_stream_scalar,
+};
+
+static inline void pattern_stream_fence(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif // PATTERN_SIMD_X86
+
+/**
+ * Stores `count` 32-bit values as little-endian integers of `width`
+ * bytes (1 or 2); every value must fit
+ *
+ * dst needs no alignment.
+ */
+static inline void pattern_narrow_scalar(char *dst, const uint32_t *src,
+                                         size_t count, size_t width) {
+    for (size_t j = 0; j < count; j++) {
+        dst[j * width] = (char)src[j];
+        if (width == 2) {
+            dst[j * 2 + 1] = (char)(src[j] >> 8);
+        }
+    }
+}
+
+#if PATTERN_SIMD_X86
+
+/*
+ * Vector variants of pattern_narrow_scalar(). Values are small and
+ * non-negative, so the saturating packs (packus) narrow them exactly;
+ * AVX2 packs within 128-bit lanes and needs a permute to restore the
+ * order. AVX-512F has truncating stores (vpmovdw, vpmovdb) that also
+ * take a mask, so the tail needs no scalar loop.
+ */
+__attribute__((target("sse4.2"))) static void pattern_narrow_sse42(
+        char *dst, const uint32_t *src, size_t count, size_t width) {
+    size_t j = 0;
+    if (width == 2) {
+        for (; j + 8 <= count; j += 8) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(src + j));
+            __m128i b = _mm_loadu_si128((const __m128i *)(src + j + 4));
+            _mm_storeu_si128((__m128i *)(dst + j * 2),
+                             _mm_packus_epi32(a, b));
+        }
+    } else {
+        for (; j + 16 <= count; j += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(src + j));
+            __m128i b = _mm_loadu_si128((const __m128i *)(src + j + 4));
+            __m128i c = _mm_loadu_si128((const __m128i *)(src + j + 8));
+            __m128i d = _mm_loadu_si128((const __m128i *)(src + j + 12));
+            _mm_storeu_si128((__m128i *)(dst + j),
+                             _mm_packus_epi16(_mm_packus_epi32(a, b),
+                                              _mm_packus_epi32(c, d)));
+        }
+    }
+    pattern_narrow_scalar(dst + j * width, src + j, count - j, width);
+}
+
+__attribute__((target("avx2"))) static void pattern_narrow_avx2(
+        char *dst, const uint32_t *src, size_t count, size_t width) {
+    size_t j = 0;
+    if (width == 2) {
+        for (; j + 16 <= count; j += 16) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(src + j));
+            __m256i b = _mm256_loadu_si256((const __m256i *)(src + j + 8));
+            _mm256_storeu_si256(
+                (__m256i *)(dst + j * 2),
+                _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xd8));
+        }
+    } else {
+        for (; j + 32 <= count; j += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(src + j));
+            __m256i b = _mm256_loadu_si256((const __m256i *)(src + j + 8));
+            __m256i c = _mm256_loadu_si256((const __m256i *)(src + j + 16));
+            __m256i d = _mm256_loadu_si256((const __m256i *)(src + j + 24));
+            __m256i ab =
+                _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xd8);
+            __m256i cd =
+                _mm256_permute4x64_epi64(_mm256_packus_epi32(c, d), 0xd8);
+            _mm256_storeu_si256(
+                (__m256i *)(dst + j),
+                _mm256_permute4x64_epi64(_mm256_packus_epi16(ab, cd), 0xd8));
+        }
+    }
+    pattern_narrow_scalar(dst + j * width, src + j, count - j, width);
+}
+
+__attribute__((target("avx512f"))) static void pattern_narrow_avx512(
+        char *dst, const uint32_t *src, size_t count, size_t width) {
+    for (size_t j = 0; j < count; j += 16) {
+        __mmask16 keep = count - j >= 16
+                             ? (__mmask16)0xffff
+                             : (__mmask16)((1u << (count - j)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(keep, src + j);
+        if (width == 2) {
+            _mm512_mask_cvtepi32_storeu_epi16(dst + j * 2, keep, v);
+        } else {
+            _mm512_mask_cvtepi32_storeu_epi8(dst + j, keep, v);
+        }
+    }
+}
+
+static void (*const pattern_narrow_variants[PATTERN_ISAS])(
+        char *, const uint32_t *, size_t, size_t) = {
+    pattern_narrow_scalar,
+    pattern_narrow_sse42,
+    pattern_narrow_avx2,
+    pattern_narrow_avx512,
+};
+
+#else
+
+static void (*const pattern_narrow_variants[PATTERN_ISAS])(
+        char *, const uint32_t *, size_t, size_t) = {
+    pattern_narrow_scalar,
+    pattern_narrow_scalar,
+    pattern_narrow_scalar,
+    pattern_narrow_scalar,
+};
+
+#endif // PATTERN_SIMD_X86
+
+#endif // PATTERN_SIMD_H
@@ -0,0 +1,201 @@
+/**
+ * pattern_static.hpp
+ *
+ * Both patterns generated at compile time, for C++17 and later.
+ *
+ * For the small fixed sizes a binary embeds (banners, test fixtures),
+ * the text is built by the compiler and stored in .rodata, so printing it
+ * is one write of static bytes with no formatting at all:
+ *
+ *   #include "pattern_static.hpp"
+ *
+ *   std::fwrite(pattern::triangle<5>.data(), 1,
+ *               pattern::triangle<5>.size(), stdout);
+ *   pattern::write_all(STDOUT_FILENO, pattern::concentric_view<4>);
+ *
+ * pattern::triangle<N> and pattern::concentric<N> are constexpr
+ * std::array<char, bytes> variables, exactly the bytes triangle.c and
+ * concentric_square.c print for N (no terminating NUL). They are made by
+ * the same algorithms: the triangle with print_triangle()'s single loop
+ * over stars, which ends a row whenever the star count reaches the next
+ * triangular number, and the square with print_concentric_square()'s
+ * diagonal decomposition, max(n-i, n-j) above the anti-diagonal and
+ * max(i-n, j-n) + 2 below it. Sizes come from the closed forms in
+ * pattern_triangle.h and pattern_concentric.h.
+ *
+ * Only sizes up to PATTERN_STATIC_MAX_N are accepted: the text grows as
+ * n², and compilers cap the work of one constant evaluation (GCC's
+ * -fconstexpr-ops-limit). Larger patterns belong to the runtime engines.
+ *
+ * Compile: g++ -std=c++17 -O2 program.cpp
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_STATIC_HPP
+#define PATTERN_STATIC_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <string_view>
+
+#include <unistd.h>
+
+// Largest n generated at compile time (a 127×127 square, 48 KB of text)
+#define PATTERN_STATIC_MAX_N 64
+
+namespace pattern {
+
+namespace detail {
+
+/**
+ * Number of decimal digits in v (v >= 1)
+ */
+constexpr std::size_t digits(std::size_t v) {
+    std::size_t d = 1;
+    while (v >= 10) {
+        v /= 10;
+        d++;
+    }
+    return d;
+}
+
+/**
+ * Triangle bytes for height n: n(n+1) for the stars, n newlines
+ */
+constexpr std::size_t triangle_bytes(std::size_t n) {
+    return n * (n + 2);
+}
+
+/**
+ * Concentric square bytes for n: ring v holds 8(v-1) cells of
+ * digits(v)+1 bytes (the center one cell), plus a newline per row
+ */
+constexpr std::size_t concentric_bytes(std::size_t n) {
+    std::size_t total = 2 + (2 * n - 1);
+    for (std::size_t v = 2; v <= n; v++) {
+        total += 8 * (v - 1) * (digits(v) + 1);
+    }
+    return total;
+}
+
+/**
+ * print_triangle() into an array: one loop over the n(n+1)/2 stars, with
+ * a newline whenever the star count reaches the row's triangular number
+ */
+template <std::size_t N>
+constexpr std::array<char, triangle_bytes(N)> make_triangle() {
+    std::array<char, triangle_bytes(N)> text{};
+    std::size_t at = 0;
+    std::size_t row = 1;
+    for (std::size_t i = 1; i <= N * (N + 1) / 2; i++) {
+        text[at++] = '*';
+        text[at++] = ' ';
+        if (i == row * (row + 1) / 2) {
+            text[at++] = '\n';
+            row++;
+        }
+    }
+    return text;
+}
+
+/**
+ * print_concentric_square() into an array: the grid is split along the
+ * anti-diagonal, with a distance formula for each side
+ */
+template <std::size_t N>
+constexpr std::array<char, concentric_bytes(N)> make_concentric() {
+    std::array<char, concentric_bytes(N)> text{};
+    std::size_t at = 0;
+    long n = static_cast<long>(N);
+    long m = 2 * n - 1;
+    for (long i = 0; i < m; i++) {
+        for (long j = 0; j < m; j++) {
+            long v = i + j < m ? (n - i > n - j ? n - i : n - j)
+                               : (i - n > j - n ? i - n : j - n) + 2;
+            std::size_t d = digits(static_cast<std::size_t>(v));
+            for (std::size_t k = d; k > 0; k--) {
+                text[at + k - 1] = static_cast<char>('0' + v % 10);
+                v /= 10;
+            }
+            at += d;
+            text[at++] = ' ';
+        }
+        text[at++] = '\n';
+    }
+    return text;
+}
+
+template <std::size_t N>
+constexpr void check_size() {
+    static_assert(N >= 1, "n must be a positive integer");
+    static_assert(N <= PATTERN_STATIC_MAX_N,
+                  "n above PATTERN_STATIC_MAX_N: use the runtime engines");
+}
+
+template <std::size_t N>
+constexpr std::array<char, triangle_bytes(N)> checked_triangle() {
+    check_size<N>();
+    return make_triangle<N>();
+}
+
+template <std::size_t N>
+constexpr std::array<char, concentric_bytes(N)> checked_concentric() {
+    check_size<N>();
+    return make_concentric<N>();
+}
+
+} // namespace detail
+
+/**
+ * Triangle of height N, as printed by triangle.c
+ */
+template <std::size_t N>
+inline constexpr std::array<char, detail::triangle_bytes(N)> triangle =
+    detail::checked_triangle<N>();
+
+/**
+ * Concentric square for N, as printed by concentric_square.c
+ */
+template <std::size_t N>
+inline constexpr std::array<char, detail::concentric_bytes(N)> concentric =
+    detail::checked_concentric<N>();
+
+template <std::size_t N>
+inline constexpr std::string_view triangle_view{triangle<N>.data(),
+                                                triangle<N>.size()};
+
+template <std::size_t N>
+inline constexpr std::string_view concentric_view{concentric<N>.data(),
+                                                  concentric<N>.size()};
+
+/**
+ * Writes all of text to fd, retrying short writes
+ *
+ * @return 0 on success, otherwise the errno of the failed write
+ */
+inline int write_all(int fd, std::string_view text) {
+    while (!text.empty()) {
+        ssize_t done = ::write(fd, text.data(), text.size());
+        if (done < 0 && errno == EINTR) {
+            continue;
+        }
+        if (done < 0) {
+            return errno;
+        }
+        text.remove_prefix(static_cast<std::size_t>(done));
+    }
+    return 0;
+}
+
+// The output of both programs for small n, checked by the compiler
+static_assert(triangle_view<3> == "* \n* * \n* * * \n");
+static_assert(concentric_view<2> == "2 2 2 \n2 1 2 \n2 2 2 \n");
+static_assert(concentric_view<10>.size() == 813);
+
+} // namespace pattern
+
+#endif // PATTERN_STATIC_HPP
@@ -0,0 +1,413 @@
+/**
+ * pattern_table_data.h
+ *
+ * Generated by scripts/gen_tables.c; do not edit.
+ */
+
+#ifndef PATTERN_TABLE_DATA_H
+#define PATTERN_TABLE_DATA_H
+
+// Largest n in the tables
+#define PATTERN_TABLE_MAX_N 16
+
+static const char *const pattern_table_triangle[PATTERN_TABLE_MAX_N + 1] = {
+    NULL,
+    "* \n",
+    "* \n"
+    "* * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n"
+    "* * * * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n"
+    "* * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n"
+    "* * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n"
+    "* * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * * \n",
+    "* \n"
+    "* * \n"
+    "* * * \n"
+    "* * * * \n"
+    "* * * * * \n"
+    "* * * * * * \n"
+    "* * * * * * * \n"
+    "* * * * * * * * \n"
+    "* * * * * * * * * \n"
+    "* * * * * * * * * * \n"
+    "* * * * * * * * * * * \n"
+    "* * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * * \n"
+    "* * * * * * * * * * * * * * * * \n",
+};
+
+static const char *const pattern_table_concentric[PATTERN_TABLE_MAX_N + 1] = {
+    NULL,
+    "1 \n",
+    "2 2 2 \n"
+    "2 1 2 \n"
+    "2 2 2 \n",
+    "3 3 3 3 3 \n"
+    "3 2 2 2 3 \n"
+    "3 2 1 2 3 \n"
+    "3 2 2 2 3 \n"
+    "3 3 3 3 3 \n",
+    "4 4 4 4 4 4 4 \n"
+    "4 3 3 3 3 3 4 \n"
+    "4 3 2 2 2 3 4 \n"
+    "4 3 2 1 2 3 4 \n"
+    "4 3 2 2 2 3 4 \n"
+    "4 3 3 3 3 3 4 \n"
+    "4 4 4 4 4 4 4 \n",
+    "5 5 5 5 5 5 5 5 5 \n"
+    "5 4 4 4 4 4 4 4 5 \n"
+    "5 4 3 3 3 3 3 4 5 \n"
+    "5 4 3 2 2 2 3 4 5 \n"
+    "5 4 3 2 1 2 3 4 5 \n"
+    "5 4 3 2 2 2 3 4 5 \n"
+    "5 4 3 3 3 3 3 4 5 \n"
+    "5 4 4 4 4 4 4 4 5 \n"
+    "5 5 5 5 5 5 5 5 5 \n",
+    "6 6 6 6 6 6 6 6 6 6 6 \n"
+    "6 5 5 5 5 5 5 5 5 5 6 \n"
+    "6 5 4 4 4 4 4 4 4 5 6 \n"
+    "6 5 4 3 3 3 3 3 4 5 6 \n"
+    "6 5 4 3 2 2 2 3 4 5 6 \n"
+    "6 5 4 3 2 1 2 3 4 5 6 \n"
+    "6 5 4 3 2 2 2 3 4 5 6 \n"
+    "6 5 4 3 3 3 3 3 4 5 6 \n"
+    "6 5 4 4 4 4 4 4 4 5 6 \n"
+    "6 5 5 5 5 5 5 5 5 5 6 \n"
+    "6 6 6 6 6 6 6 6 6 6 6 \n",
+    "7 7 7 7 7 7 7 7 7 7 7 7 7 \n"
+    "7 6 6 6 6 6 6 6 6 6 6 6 7 \n"
+    "7 6 5 5 5 5 5 5 5 5 5 6 7 \n"
+    "7 6 5 4 4 4 4 4 4 4 5 6 7 \n"
+    "7 6 5 4 3 3 3 3 3 4 5 6 7 \n"
+    "7 6 5 4 3 2 2 2 3 4 5 6 7 \n"
+    "7 6 5 4 3 2 1 2 3 4 5 6 7 \n"
+    "7 6 5 4 3 2 2 2 3 4 5 6 7 \n"
+    "7 6 5 4 3 3 3 3 3 4 5 6 7 \n"
+    "7 6 5 4 4 4 4 4 4 4 5 6 7 \n"
+    "7 6 5 5 5 5 5 5 5 5 5 6 7 \n"
+    "7 6 6 6 6 6 6 6 6 6 6 6 7 \n"
+    "7 7 7 7 7 7 7 7 7 7 7 7 7 \n",
+    "8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 \n"
+    "8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 \n"
+    "8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 \n"
+    "8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 \n"
+    "8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 \n"
+    "8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 \n"
+    "8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 \n"
+    "8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 \n"
+    "8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 \n"
+    "8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 \n"
+    "8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 \n"
+    "8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 \n"
+    "8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 \n"
+    "8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 \n"
+    "8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 \n",
+    "9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 \n"
+    "9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 \n"
+    "9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 \n"
+    "9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 \n"
+    "9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 \n"
+    "9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 \n"
+    "9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 \n"
+    "9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 \n"
+    "9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 \n"
+    "9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 \n",
+    "10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 \n"
+    "10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 \n"
+    "10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 \n"
+    "10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 \n"
+    "10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 \n"
+    "10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 \n"
+    "10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 \n"
+    "10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 \n"
+    "10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 \n"
+    "10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 \n",
+    "11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 \n"
+    "11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 \n"
+    "11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 \n"
+    "11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 \n"
+    "11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 \n"
+    "11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 \n"
+    "11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 \n"
+    "11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 \n"
+    "11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 \n"
+    "11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 \n",
+    "12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 \n"
+    "12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 \n"
+    "12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 \n"
+    "12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 \n"
+    "12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 \n"
+    "12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 \n"
+    "12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 \n"
+    "12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 \n"
+    "12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 \n"
+    "12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 \n",
+    "13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 \n"
+    "13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 \n"
+    "13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 \n"
+    "13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 \n"
+    "13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 \n"
+    "13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 \n"
+    "13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 \n"
+    "13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 \n"
+    "13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 \n"
+    "13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 \n",
+    "14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 \n"
+    "14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 \n"
+    "14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 \n"
+    "14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 \n"
+    "14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 \n"
+    "14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 \n"
+    "14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 \n"
+    "14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 \n"
+    "14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 \n"
+    "14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 \n",
+    "15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 \n"
+    "15 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 15 \n"
+    "15 14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 15 \n"
+    "15 14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 15 \n"
+    "15 14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 15 \n"
+    "15 14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 15 \n"
+    "15 14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 15 \n"
+    "15 14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 15 \n"
+    "15 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 15 \n"
+    "15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 \n",
+    "16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 \n"
+    "16 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 16 \n"
+    "16 15 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 15 16 \n"
+    "16 15 14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 15 16 \n"
+    "16 15 14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 3 2 2 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 3 3 3 3 3 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 4 4 4 4 4 4 4 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 5 5 5 5 5 5 5 5 5 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 6 6 6 6 6 6 6 6 6 6 6 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 7 7 7 7 7 7 7 7 7 7 7 7 7 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 8 8 8 8 8 8 8 8 8 8 8 8 8 8 8 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 9 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 10 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 11 12 13 14 15 16 \n"
+    "16 15 14 13 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 12 13 14 15 16 \n"
+    "16 15 14 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 13 14 15 16 \n"
+    "16 15 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 14 15 16 \n"
+    "16 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 15 16 \n"
+    "16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 16 \n",
+};
+
+#endif // PATTERN_TABLE_DATA_H
@@ -0,0 +1,344 @@
+/**
+ * pattern_triangle.h
+ *
+ * Triangle rendering on top of the shared output layer.
+ *
+ * Every row of the triangle is a suffix of one master line:
+ *
+ *   master (n = 4):  "* * * * \n"
+ *   row 1:                 "* \n"      (last 3 bytes)
+ *   row 2:               "* * \n"      (last 5 bytes)
+ *   row 4:           "* * * * \n"      (all 9 bytes)
+ *
+ * Row r is 2r+1 bytes long and starts 2(n-r) bytes into the master, so
+ * the whole pattern is emitted as n references into a single buffer
+ * that is formatted once. The master for height n also serves every
+ * smaller height, so it is only rebuilt when a taller triangle is asked
+ * for.
+ *
+ * The master is preceded by 2(n-1) spaces in the same mapping, which
+ * gives the other variants their rows as slices too:
+ *
+ *   buffer (n = 3):  "    * * * \n"
+ *   right, row 1:    "    * "  + "\n"   (pad, then the first stars)
+ *   pyramid, row 2:     " * * " + "\n"
+ *   inverted:        the left rows, last to first
+ *
+ * A padded row ends before the stars do, so its newline is a second
+ * reference, to the master's own. Every variant therefore costs n or
+ * 2n references and no formatting, like the left triangle.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_TRIANGLE_H
+#define PATTERN_TRIANGLE_H
+
+#include <stdlib.h>
+
+#include "pattern_io.h"
+
+// Triangle variants: how rows are aligned and ordered
+#define TRIANGLE_LEFT     0     // what triangle.c prints
+#define TRIANGLE_RIGHT    1     // rows padded against the right edge
+#define TRIANGLE_INVERTED 2     // the left triangle, longest row first
+#define TRIANGLE_PYRAMID  3     // rows centered, one space per step
+#define TRIANGLE_VARIANTS 4
+
+static const char *const triangle_variant_names[TRIANGLE_VARIANTS] = {
+    "left", "right", "inverted", "pyramid",
+};
+
+/**
+ * Shared master row: "* " repeated n times, then '\n', after 2(n-1)
+ * spaces of padding
+ */
+typedef struct triangle_master {
+    char *row;
+    char *map;          // the mapping: padding, then row
+    size_t n;           // tallest triangle the master can serve
+    size_t map_size;
+} triangle_master;
+
+/**
+ * Looks up a variant by name
+ *
+ * @return TRIANGLE_*, or -1 if the name is unknown
+ */
+static inline int triangle_variant_parse(const char *name) {
+    for (int v = 0; v < TRIANGLE_VARIANTS; v++) {
+        if (strcmp(name, triangle_variant_names[v]) == 0) {
+            return v;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Bytes in row r (1-based): r tokens of "* " plus the newline
+ */
+static inline size_t triangle_row_bytes(size_t r) {
+    return 2 * r + 1;
+}
+
+/**
+ * Total output bytes for height n: sum of (2r+1) = n(n+1) + n = n(n+2)
+ */
+static inline unsigned long long triangle_total_bytes(unsigned long long n) {
+    return n * (n + 2);
+}
+
+/**
+ * Bytes in row r (1-based, top to bottom) of a variant of height n
+ */
+static inline size_t triangle_variant_row_bytes(int variant, size_t n,
+                                                size_t r) {
+    switch (variant) {
+    case TRIANGLE_RIGHT:
+        return 2 * n + 1;
+    case TRIANGLE_INVERTED:
+        return triangle_row_bytes(n + 1 - r);
+    case TRIANGLE_PYRAMID:
+        return n + r + 1;
+    default:
+        return triangle_row_bytes(r);
+    }
+}
+
+/**
+ * Total bytes of a variant: n(n+2) for the left and inverted ones,
+ * n(2n+1) right-aligned, and sum of (n+r+1) = 3n(n+1)/2 as a pyramid
+ */
+static inline unsigned long long triangle_variant_total_bytes(
+        int variant, unsigned long long n) {
+    switch (variant) {
+    case TRIANGLE_RIGHT:
+        return n * (2 * n + 1);
+    case TRIANGLE_PYRAMID:
+        return 3 * n * (n + 1) / 2;
+    default:
+        return triangle_total_bytes(n);
+    }
+}
+
+/**
+ * Makes sure the master covers height n
+ *
+ * A taller master is built in a fresh mapping and the old one unmapped,
+ * never rewritten in place: a pipe may still reference its pages.
+ *
+ * @return 0 on success, -1 if memory could not be mapped
+ */
+static inline int triangle_master_reserve(triangle_master *tm, size_t n) {
+    if (n <= tm->n) {
+        return 0;
+    }
+
+    size_t pad = 2 * (n - 1);
+    size_t map_size = pattern_page_round(pad + triangle_row_bytes(n));
+    char *map = pattern_map(map_size);
+    if (map == NULL) {
+        return -1;
+    }
+
+    char *row = map + pad;
+    memset(map, ' ', pad);
+    pattern_fill(row, "* ", 2, 2 * n);
+    row[2 * n] = '\n';
+
+    pattern_unmap(tm->map, tm->map_size);
+    tm->row = row;
+    tm->map = map;
+    tm->n = n;
+    tm->map_size = map_size;
+    return 0;
+}
+
+/**
+ * Row r (1-based) of any triangle up to the master's height
+ */
+static inline const char *triangle_master_row(const triangle_master *tm,
+                                              size_t r) {
+    return tm->row + 2 * (tm->n - r);
+}
+
+static inline void triangle_master_free(triangle_master *tm) {
+    pattern_unmap(tm->map, tm->map_size);
+    tm->row = NULL;
+    tm->map = NULL;
+    tm->n = 0;
+    tm->map_size = 0;
+}
+
+/**
+ * Emits a triangle of height n as references into the master row
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int triangle_write(pattern_writer *w, triangle_master *tm,
+                                 size_t n) {
+    // Queued rows may still point into a master about to be unmapped
+    if (n > tm->n && pattern_writer_flush(w) != 0) {
+        return -1;
+    }
+    if (triangle_master_reserve(tm, n) != 0) {
+        w->error = ENOMEM;
+        return -1;
+    }
+    for (size_t r = 1; r <= n; r++) {
+        if (pattern_writer_ref(w, triangle_master_row(tm, r),
+                               triangle_row_bytes(r)) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Row r (1-based, top to bottom) of a variant as a slice of the master,
+ * which must cover n
+ *
+ * @param len Set to the slice length; for the padded variants the row's
+ *            newline is not part of the slice (triangle_master_newline)
+ */
+static inline const char *triangle_variant_slice(const triangle_master *tm,
+                                                 int variant, size_t n,
+                                                 size_t r, size_t *len) {
+    switch (variant) {
+    case TRIANGLE_RIGHT:
+        *len = 2 * n;
+        return tm->row - 2 * (n - r);
+    case TRIANGLE_INVERTED:
+        *len = triangle_row_bytes(n + 1 - r);
+        return triangle_master_row(tm, n + 1 - r);
+    case TRIANGLE_PYRAMID:
+        *len = n + r;
+        return tm->row - (n - r);
+    default:
+        *len = triangle_row_bytes(r);
+        return triangle_master_row(tm, r);
+    }
+}
+
+static inline int triangle_variant_padded(int variant) {
+    return variant == TRIANGLE_RIGHT || variant == TRIANGLE_PYRAMID;
+}
+
+static inline const char *triangle_master_newline(const triangle_master *tm) {
+    return tm->row + 2 * tm->n;
+}
+
+/**
+ * Emits a variant of height n as references into the master
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int triangle_variant_write(pattern_writer *w,
+                                         triangle_master *tm, int variant,
+                                         size_t n) {
+    if (n > tm->n && pattern_writer_flush(w) != 0) {
+        return -1;
+    }
+    if (triangle_master_reserve(tm, n) != 0) {
+        w->error = ENOMEM;
+        return -1;
+    }
+    int padded = triangle_variant_padded(variant);
+    for (size_t r = 1; r <= n; r++) {
+        size_t len;
+        const char *row = triangle_variant_slice(tm, variant, n, r, &len);
+        if (pattern_writer_ref(w, row, len) != 0 ||
+            (padded &&
+             pattern_writer_ref(w, triangle_master_newline(tm), 1) != 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Formats a variant into memory; the master must cover n
+ *
+ * @param dst triangle_variant_total_bytes(variant, n) bytes
+ */
+static inline void triangle_variant_copy(const triangle_master *tm,
+                                         int variant, size_t n, char *dst) {
+    int padded = triangle_variant_padded(variant);
+    for (size_t r = 1; r <= n; r++) {
+        size_t len;
+        const char *row = triangle_variant_slice(tm, variant, n, r, &len);
+        memcpy(dst, row, len);
+        dst += len;
+        if (padded) {
+            *dst++ = '\n';
+        }
+    }
+}
+
+/**
+ * Checks every variant, written as references and copied into memory,
+ * against rows built one space and star at a time
+ *
+ * @return 0 if all of them match, -1 otherwise
+ */
+static inline int triangle_variants_check(void) {
+    static const size_t sizes[] = {1, 2, 3, 10, 99, 300};
+    int fd = memfd_create("triangle_variants", 0);
+    triangle_master tm = {0};
+    int status = fd < 0 ? -1 : 0;
+    for (int v = 0; v < TRIANGLE_VARIANTS && status == 0; v++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            size_t n = sizes[i];
+            size_t bytes = (size_t)triangle_variant_total_bytes(v, n);
+            char *want = malloc(bytes + 1);
+            char *copied = malloc(bytes);
+            char *got = malloc(bytes + 1);
+            char *at = want;
+            for (size_t r = 1; r <= n && want != NULL; r++) {
+                size_t stars = v == TRIANGLE_INVERTED ? n + 1 - r : r;
+                size_t pad = v == TRIANGLE_RIGHT     ? 2 * (n - r)
+                             : v == TRIANGLE_PYRAMID ? n - r
+                                                     : 0;
+                memset(at, ' ', pad);
+                at += pad;
+                for (size_t s = 0; s < stars; s++) {
+                    *at++ = '*';
+                    *at++ = ' ';
+                }
+                *at++ = '\n';
+            }
+            pattern_writer w;
+            int ok = want != NULL && copied != NULL && got != NULL &&
+                     (size_t)(at - want) == bytes &&
+                     ftruncate(fd, 0) == 0 &&
+                     lseek(fd, 0, SEEK_SET) == 0 &&
+                     pattern_writer_init(&w, fd, PATTERN_SINK_WRITEV) == 0;
+            if (ok) {
+                ok = triangle_variant_write(&w, &tm, v, n) == 0;
+                ok &= pattern_writer_close(&w) == 0;
+            }
+            if (ok) {
+                triangle_variant_copy(&tm, v, n, copied);
+                ok = pread(fd, got, bytes + 1, 0) == (ssize_t)bytes &&
+                     memcmp(want, got, bytes) == 0 &&
+                     memcmp(want, copied, bytes) == 0;
+            }
+            free(want);
+            free(copied);
+            free(got);
+            if (!ok) {
+                status = -1;
+                break;
+            }
+        }
+    }
+    triangle_master_free(&tm);
+    if (fd >= 0) {
+        close(fd);
+    }
+    return status;
+}
+
+#endif // PATTERN_TRIANGLE_H
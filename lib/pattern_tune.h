@@ -0,0 +1,682 @@
+/**
+ * pattern_tune.h
+ *
+ * Engine selection by size, calibrated per machine.
+ *
+ * No single engine is best at every size. Below a few kilobytes,
+ * mapping and formatting a master costs more than the output; far above
+ * the cache, writing straight into the output file's pages can beat
+ * writev, and a pool only pays off once the pattern is large enough to
+ * keep its workers busy. pattern_render_adaptive() picks, per pattern:
+ *
+ *   n <= table_max                 the table text (pattern_table.h)
+ *   bytes >= mmap_min, on a file   pattern_render_file()
+ *   bytes >= buffer_min            pattern_render_memory()
+ *   otherwise                      pattern_render(), which hands
+ *                                  patterns of parallel_min bytes or
+ *                                  more to the pool
+ *
+ * The profile also names the sink used when the output is a pipe:
+ * vmsplice saves a copy per page, but every splice retires the staging
+ * arena, so which one wins depends on the machine and the shapes.
+ *
+ * The thresholds form a pattern_profile. pattern_tune_run() measures
+ * each engine on this machine and sets them where one starts to beat
+ * the default path; the profile is kept in a small text file:
+ *
+ *   # pattern profile
+ *   table_max 16
+ *   buffer_min off
+ *   mmap_min 16777216
+ *   parallel_min 4194304
+ *   pipe_sink writev
+ *
+ * Its path is the --profile argument, else $PATTERN_PROFILE, else
+ * $XDG_CONFIG_HOME/pattern-algorithms/profile (~/.config by default).
+ * Without a profile the defaults keep the engines' built-in behaviour,
+ * plus the tables.
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#ifndef PATTERN_TUNE_H
+#define PATTERN_TUNE_H
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pattern_table.h"
+
+// Threshold that is never reached; "off" in the profile file
+#define PATTERN_PROFILE_OFF ULLONG_MAX
+
+// Longest profile path
+#define PATTERN_PROFILE_PATH_MAX 4096
+
+// Autotune: output sizes measured for the large-pattern engines, from
+// PATTERN_TUNE_MIN_BYTES up by factors of 4
+#define PATTERN_TUNE_MIN_BYTES (256u << 10)
+#define PATTERN_TUNE_MAX_BYTES (64u << 20)
+#define PATTERN_TUNE_SIZES     5
+
+// Best of this many runs per measurement (small patterns: many more,
+// their times are microseconds)
+#define PATTERN_TUNE_REPS       3
+#define PATTERN_TUNE_SMALL_REPS 50
+
+// An engine must be this much faster than the default path (percent)
+#define PATTERN_TUNE_MARGIN 5
+
+/**
+ * Size thresholds for pattern_render_adaptive()
+ */
+typedef struct pattern_profile {
+    size_t table_max;                   // largest n served from tables
+    unsigned long long buffer_min;      // bytes, or PATTERN_PROFILE_OFF
+    unsigned long long mmap_min;
+    unsigned long long parallel_min;
+    int pipe_sink;                      // PATTERN_SINK_WRITEV or _SPLICE
+} pattern_profile;
+
+static inline void pattern_profile_defaults(pattern_profile *pf) {
+    pf->table_max = PATTERN_TABLE_MAX_N;
+    pf->buffer_min = PATTERN_PROFILE_OFF;
+    pf->mmap_min = PATTERN_PROFILE_OFF;
+    pf->parallel_min = PATTERN_PARALLEL_MIN;
+    pf->pipe_sink = PATTERN_SINK_WRITEV;
+}
+
+/**
+ * Resolves the profile path: `given`, else $PATTERN_PROFILE, else
+ * $XDG_CONFIG_HOME or ~/.config, then /pattern-algorithms/profile
+ *
+ * @param buf PATTERN_PROFILE_PATH_MAX bytes
+ * @return The path, or NULL if there is no home directory to use
+ */
+static inline const char *pattern_profile_path(const char *given,
+                                               char *buf) {
+    if (given != NULL) {
+        return given;
+    }
+    const char *env = getenv("PATTERN_PROFILE");
+    if (env != NULL && *env != '\0') {
+        return env;
+    }
+    const char *config = getenv("XDG_CONFIG_HOME");
+    const char *home = getenv("HOME");
+    int len;
+    if (config != NULL && *config != '\0') {
+        len = snprintf(buf, PATTERN_PROFILE_PATH_MAX,
+                       "%s/pattern-algorithms/profile", config);
+    } else if (home != NULL && *home != '\0') {
+        len = snprintf(buf, PATTERN_PROFILE_PATH_MAX,
+                       "%s/.config/pattern-algorithms/profile", home);
+    } else {
+        return NULL;
+    }
+    return len < PATTERN_PROFILE_PATH_MAX ? buf : NULL;
+}
+
+static inline int pattern_profile_parse_value(const char *text,
+                                              unsigned long long *v) {
+    if (strcmp(text, "off") == 0) {
+        *v = PATTERN_PROFILE_OFF;
+        return 0;
+    }
+    char *end;
+    errno = 0;
+    *v = strtoull(text, &end, 10);
+    return text[0] >= '0' && text[0] <= '9' && *end == '\0' && errno == 0
+               ? 0
+               : -1;
+}
+
+/**
+ * Reads a profile; keys it does not set keep their current values, and
+ * unknown keys are skipped
+ *
+ * @return 0 on success, 1 if the file does not exist, -1 if it could not
+ *         be read or a line is malformed (errno set)
+ */
+static inline int pattern_profile_load(pattern_profile *pf,
+                                       const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return errno == ENOENT ? 1 : -1;
+    }
+    char line[256];
+    int status = 0;
+    while (status == 0 && fgets(line, sizeof(line), f) != NULL) {
+        char key[64];
+        char value[64];
+        unsigned long long v;
+        char *text = line + strspn(line, " \t");
+        if (*text == '#' || *text == '\n' || *text == '\0') {
+            continue;
+        }
+        if (sscanf(text, "%63s %63s", key, value) != 2) {
+            errno = EINVAL;
+            status = -1;
+        } else if (strcmp(key, "pipe_sink") == 0) {
+            if (strcmp(value, "writev") == 0) {
+                pf->pipe_sink = PATTERN_SINK_WRITEV;
+            } else if (strcmp(value, "splice") == 0) {
+                pf->pipe_sink = PATTERN_SINK_SPLICE;
+            } else {
+                errno = EINVAL;
+                status = -1;
+            }
+        } else if (pattern_profile_parse_value(value, &v) != 0) {
+            errno = EINVAL;
+            status = -1;
+        } else if (strcmp(key, "table_max") == 0) {
+            pf->table_max = v < PATTERN_TABLE_MAX_N ? (size_t)v
+                                                    : PATTERN_TABLE_MAX_N;
+        } else if (strcmp(key, "buffer_min") == 0) {
+            pf->buffer_min = v;
+        } else if (strcmp(key, "mmap_min") == 0) {
+            pf->mmap_min = v;
+        } else if (strcmp(key, "parallel_min") == 0) {
+            pf->parallel_min = v;
+        }
+    }
+    if (status == 0 && ferror(f)) {
+        status = -1;
+    }
+    fclose(f);
+    return status;
+}
+
+static inline void pattern_profile_print_value(FILE *to,
+                                               unsigned long long v) {
+    if (v == PATTERN_PROFILE_OFF) {
+        fputs("off", to);
+    } else {
+        fprintf(to, "%llu", v);
+    }
+}
+
+/**
+ * Writes the profile as "key value" lines
+ */
+static inline void pattern_profile_print(const pattern_profile *pf,
+                                         FILE *to) {
+    fprintf(to, "table_max %zu\nbuffer_min ", pf->table_max);
+    pattern_profile_print_value(to, pf->buffer_min);
+    fputs("\nmmap_min ", to);
+    pattern_profile_print_value(to, pf->mmap_min);
+    fputs("\nparallel_min ", to);
+    pattern_profile_print_value(to, pf->parallel_min);
+    fprintf(to, "\npipe_sink %s\n",
+            pf->pipe_sink == PATTERN_SINK_SPLICE ? "splice" : "writev");
+}
+
+/**
+ * Saves a profile, creating its directories if needed; the file is
+ * replaced in one rename, so readers never see half of it
+ *
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int pattern_profile_save(const pattern_profile *pf,
+                                       const char *path) {
+    char dir[PATTERN_PROFILE_PATH_MAX];
+    char tmp[PATTERN_PROFILE_PATH_MAX + 8];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (slash != NULL && slash != dir) {
+        *slash = '\0';
+        // mkdir -p: each missing component, from the root down
+        for (char *c = dir + 1; ; c++) {
+            if (*c != '/' && *c != '\0') {
+                continue;
+            }
+            char end = *c;
+            *c = '\0';
+            if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+                return -1;
+            }
+            *c = end;
+            if (end == '\0') {
+                break;
+            }
+        }
+    }
+    snprintf(tmp, sizeof(tmp), "%s.new", path);
+    FILE *f = fopen(tmp, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    fputs("# pattern profile, written by --autotune\n", f);
+    pattern_profile_print(pf, f);
+    if (fclose(f) != 0 || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Dispatch                                                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Emits a pattern from the tables: one reference into them, or a copy
+ * behind renders still in flight
+ *
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_table_write(pattern_ctx *ctx, int shape,
+                                      size_t n) {
+    const char *text = pattern_table_text(shape, n);
+    if (text == NULL) {
+        ctx->out.error = ENOMEM;
+        return -1;
+    }
+    size_t bytes = (size_t)pattern_total_bytes(shape, n);
+    if (ctx->order.head < ctx->order.tail) {
+        return pattern_ctx_copy(ctx, text, bytes);
+    }
+    return pattern_writer_ref(&ctx->out, text, bytes);
+}
+
+/**
+ * Renders one pattern with the engine the profile picks for its size
+ *
+ * @param mappable The output is a regular file open for reading and
+ *                 writing, so pattern_render_file() can be used
+ * @return 0 on success, -1 on a write or mapping error
+ */
+static inline int pattern_render_adaptive(pattern_ctx *ctx,
+                                          const pattern_profile *pf,
+                                          int shape, size_t n,
+                                          int mappable) {
+    unsigned long long bytes = pattern_total_bytes(shape, n);
+    if (n <= pf->table_max && pattern_table_text(shape, n) != NULL) {
+        return pattern_table_write(ctx, shape, n);
+    }
+    // The memory engines write in place, after everything in flight
+    if (mappable && bytes >= pf->mmap_min) {
+        return pattern_ctx_flush(ctx) != 0
+                   ? -1
+                   : pattern_render_file(ctx, shape, n);
+    }
+    if (bytes >= pf->buffer_min) {
+        return pattern_ctx_flush(ctx) != 0
+                   ? -1
+                   : pattern_render_memory(ctx, shape, n);
+    }
+    return pattern_render(ctx, shape, n);
+}
+
+/**
+ * Checks every table entry against the renderers
+ *
+ * @return 0 if all of them match, -1 otherwise
+ */
+static inline int pattern_table_check(void) {
+    pattern_ctx ctx;
+    char want[4096];
+    memset(&ctx, 0, sizeof(ctx));
+    int status =
+        triangle_master_reserve(&ctx.tri, PATTERN_TABLE_MAX_N) == 0 &&
+                concentric_master_reserve(&ctx.con, PATTERN_TABLE_MAX_N) == 0
+            ? 0
+            : -1;
+    for (int shape = 0; shape < PATTERN_SHAPES && status == 0; shape++) {
+        for (size_t n = 1; n <= PATTERN_TABLE_MAX_N && status == 0; n++) {
+            size_t len = (size_t)pattern_total_bytes(shape, n);
+            const char *text = pattern_table_text(shape, n);
+            pattern_render_buffer(&ctx, shape, n, want);
+            status = text != NULL && len <= sizeof(want) &&
+                             memcmp(text, want, len) == 0
+                         ? 0
+                         : -1;
+        }
+    }
+    triangle_master_free(&ctx.tri);
+    concentric_master_free(&ctx.con);
+    return status;
+}
+
+/* ------------------------------------------------------------------ */
+/* Autotune                                                            */
+/* ------------------------------------------------------------------ */
+
+// Engines measured by pattern_tune_time()
+#define PATTERN_TUNE_TABLE    0     // table text
+#define PATTERN_TUNE_COLD     1     // writev engine, masters built first
+#define PATTERN_TUNE_WRITEV   2     // writev engine, masters warm
+#define PATTERN_TUNE_BUFFER   3
+#define PATTERN_TUNE_MMAP     4
+#define PATTERN_TUNE_PARALLEL 5     // writev engine on the pool
+
+/**
+ * Best time over `reps` runs of one engine on (shape, n), written to the
+ * scratch file behind ctx, in nanoseconds
+ *
+ * @return Nanoseconds, or 0 if a run failed
+ */
+static inline unsigned long long pattern_tune_time(pattern_ctx *ctx,
+                                                   int engine, int shape,
+                                                   size_t n, int reps) {
+    unsigned long long best = 0;
+    for (int rep = 0; rep < reps; rep++) {
+        if (ftruncate(ctx->out.fd, 0) != 0 ||
+            lseek(ctx->out.fd, 0, SEEK_SET) != 0) {
+            return 0;
+        }
+        if (engine == PATTERN_TUNE_COLD) {
+            triangle_master_free(&ctx->tri);
+            concentric_master_free(&ctx->con);
+        }
+        unsigned long long start = pattern_now_ns();
+        int failed;
+        if (engine == PATTERN_TUNE_TABLE) {
+            failed = pattern_table_write(ctx, shape, n);
+        } else if (engine == PATTERN_TUNE_BUFFER) {
+            failed = pattern_render_memory(ctx, shape, n);
+        } else if (engine == PATTERN_TUNE_MMAP) {
+            failed = pattern_render_file(ctx, shape, n);
+        } else {
+            failed = pattern_render(ctx, shape, n);
+        }
+        failed |= pattern_ctx_flush(ctx);
+        unsigned long long ns = pattern_now_ns() - start;
+        if (failed) {
+            return 0;
+        }
+        best = rep == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+/**
+ * Pipe for comparing the writev and splice sinks; a thread reads and
+ * discards whatever reaches it
+ */
+typedef struct pattern_tune_pipe {
+    int fd[2];
+    pthread_t drain;
+    unsigned long long drained;     // bytes read by the drain thread
+} pattern_tune_pipe;
+
+static inline void *pattern_tune_drain(void *arg) {
+    pattern_tune_pipe *p = arg;
+    char *buf = malloc(PATTERN_PIPE_SIZE);
+    ssize_t got;
+    while (buf != NULL &&
+           (got = read(p->fd[0], buf, PATTERN_PIPE_SIZE)) != 0) {
+        if (got > 0) {
+            __atomic_add_fetch(&p->drained, (unsigned long long)got,
+                               __ATOMIC_RELEASE);
+        } else if (errno != EINTR) {
+            break;
+        }
+    }
+    free(buf);
+    return NULL;
+}
+
+/**
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int pattern_tune_pipe_open(pattern_tune_pipe *p) {
+    p->drained = 0;
+    if (pipe2(p->fd, O_CLOEXEC) != 0) {
+        return -1;
+    }
+    // Same pipe size for both sinks, not only the splice one
+    fcntl(p->fd[1], F_SETPIPE_SZ, PATTERN_PIPE_SIZE);
+    int err = pthread_create(&p->drain, NULL, pattern_tune_drain, p);
+    if (err != 0) {
+        close(p->fd[0]);
+        close(p->fd[1]);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+static inline void pattern_tune_pipe_close(pattern_tune_pipe *p) {
+    close(p->fd[1]);
+    pthread_join(p->drain, NULL);
+    close(p->fd[0]);
+}
+
+/**
+ * Best time over `reps` runs of pattern_render() on (shape, n) into the
+ * pipe behind ctx, in nanoseconds; a run is over once the drain thread
+ * has read all of it, not when the last byte fits in the pipe
+ *
+ * @return Nanoseconds, or 0 if a run failed
+ */
+static inline unsigned long long pattern_tune_pipe_time(
+        pattern_ctx *ctx, pattern_tune_pipe *p, int shape, size_t n,
+        int reps) {
+    unsigned long long best = 0;
+    for (int rep = 0; rep < reps; rep++) {
+        unsigned long long until =
+            __atomic_load_n(&p->drained, __ATOMIC_ACQUIRE) +
+            pattern_total_bytes(shape, n);
+        unsigned long long start = pattern_now_ns();
+        if (pattern_render(ctx, shape, n) != 0 ||
+            pattern_ctx_flush(ctx) != 0) {
+            return 0;
+        }
+        while (__atomic_load_n(&p->drained, __ATOMIC_ACQUIRE) < until) {
+            sched_yield();
+        }
+        unsigned long long ns = pattern_now_ns() - start;
+        best = rep == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+/**
+ * Smallest n whose text is at least `bytes` long
+ */
+static inline size_t pattern_tune_size(int shape, unsigned long long bytes) {
+    size_t lo = 1;
+    size_t hi = 1;
+    while (pattern_total_bytes(shape, hi) < bytes) {
+        hi *= 2;
+    }
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (pattern_total_bytes(shape, mid) < bytes) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Smallest measured size from which `ns` beats `base` by the margin at
+ * every larger size too
+ *
+ * @return That size in bytes, or PATTERN_PROFILE_OFF if it never does
+ */
+static inline unsigned long long pattern_tune_threshold(
+        const unsigned long long *bytes, const unsigned long long *ns,
+        const unsigned long long *base, int sizes) {
+    unsigned long long from = PATTERN_PROFILE_OFF;
+    for (int s = sizes - 1; s >= 0; s--) {
+        if (ns[s] == 0 || base[s] == 0 ||
+            ns[s] * 100 > base[s] * (100 - PATTERN_TUNE_MARGIN)) {
+            break;
+        }
+        from = bytes[s];
+    }
+    return from;
+}
+
+/**
+ * Measures the engines on this machine and sets every threshold of the
+ * profile, reporting the measurements to `report`
+ *
+ * Output goes to an unlinked scratch file in $TMPDIR (or /tmp), which
+ * is where the mmap engine applies. The pool is measured with `threads`
+ * workers; with 1, parallel_min is left as it is. The pipe sinks are
+ * then compared on both shapes through a drained pipe; one sink serves
+ * every pattern of a run, so splice is chosen only if it wins at every
+ * size measured.
+ *
+ * @return 0 on success, -1 if the scratch file or a render failed
+ *         (errno set)
+ */
+static inline int pattern_tune_run(pattern_profile *pf, int threads,
+                                   FILE *report) {
+    const char *dir = getenv("TMPDIR");
+    char path[PATTERN_PROFILE_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/pattern-tune-XXXXXX",
+             dir != NULL && *dir != '\0' ? dir : "/tmp");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return -1;
+    }
+    unlink(path);
+
+    pattern_ctx one;
+    pattern_ctx pool;
+    int status = pattern_ctx_init(&one, fd, PATTERN_SINK_WRITEV, 1);
+    int pooled = threads > 1;
+    if (pooled &&
+        pattern_ctx_init(&pool, fd, PATTERN_SINK_WRITEV, threads) != 0) {
+        status = -1;
+    }
+    if (pooled) {
+        pool.parallel_min = 0;
+    }
+
+    // Small patterns: the tables against a one-shot render
+    size_t table_max = 0;
+    int table_wins = 1;
+    fprintf(report, "%4s %12s %12s %12s %12s\n", "n", "table tri",
+            "render tri", "table con", "render con");
+    for (size_t n = 1; n <= PATTERN_TABLE_MAX_N && status == 0; n++) {
+        unsigned long long ns[PATTERN_SHAPES][2];
+        for (int shape = 0; shape < PATTERN_SHAPES; shape++) {
+            ns[shape][0] = pattern_tune_time(&one, PATTERN_TUNE_TABLE,
+                                             shape, n,
+                                             PATTERN_TUNE_SMALL_REPS);
+            ns[shape][1] = pattern_tune_time(&one, PATTERN_TUNE_COLD, shape,
+                                             n, PATTERN_TUNE_SMALL_REPS);
+            if (ns[shape][0] == 0 || ns[shape][1] == 0) {
+                status = -1;
+            }
+            table_wins &= ns[shape][0] <= ns[shape][1];
+        }
+        if (table_wins) {
+            table_max = n;
+        }
+        fprintf(report, "%4zu %10.1fus %10.1fus %10.1fus %10.1fus\n", n,
+                ns[0][0] / 1e3, ns[0][1] / 1e3, ns[1][0] / 1e3,
+                ns[1][1] / 1e3);
+    }
+
+    // Large patterns: every engine against the default path
+    static const int engines[] = {PATTERN_TUNE_WRITEV, PATTERN_TUNE_BUFFER,
+                                  PATTERN_TUNE_MMAP, PATTERN_TUNE_PARALLEL};
+    unsigned long long bytes[PATTERN_TUNE_SIZES];
+    unsigned long long ns[4][PATTERN_TUNE_SIZES] = {{0}};
+    fprintf(report, "\n%12s %8s %10s %10s %10s %10s\n", "bytes", "n",
+            "writev", "buffer", "mmap", "parallel");
+    unsigned long long target = PATTERN_TUNE_MIN_BYTES;
+    for (int s = 0; s < PATTERN_TUNE_SIZES && status == 0; s++, target *= 4) {
+        size_t n = pattern_tune_size(PATTERN_CONCENTRIC, target);
+        bytes[s] = concentric_total_bytes(n);
+        fprintf(report, "%12llu %8zu", bytes[s], n);
+        for (int e = 0; e < 4; e++) {
+            if (engines[e] == PATTERN_TUNE_PARALLEL && !pooled) {
+                fprintf(report, " %10s", "-");
+                continue;
+            }
+            pattern_ctx *ctx = engines[e] == PATTERN_TUNE_PARALLEL ? &pool
+                                                                   : &one;
+            ns[e][s] = pattern_tune_time(ctx, engines[e],
+                                         PATTERN_CONCENTRIC, n,
+                                         PATTERN_TUNE_REPS);
+            if (ns[e][s] == 0) {
+                status = -1;
+            }
+            fprintf(report, " %8.2fms", ns[e][s] / 1e6);
+        }
+        fputc('\n', report);
+    }
+
+    // Pipes: writev against splice, both shapes, same sizes
+    pattern_tune_pipe pipe;
+    pattern_ctx sinks[2];
+    int splice_wins = 1;
+    int piped = status == 0 && pattern_tune_pipe_open(&pipe) == 0;
+    if (status == 0 && !piped) {
+        status = -1;
+    }
+    if (piped) {
+        int failed = pattern_ctx_init(&sinks[0], pipe.fd[1],
+                                      PATTERN_SINK_WRITEV, 1);
+        failed |= pattern_ctx_init(&sinks[1], pipe.fd[1],
+                                   PATTERN_SINK_SPLICE, 1);
+        if (failed) {
+            status = -1;
+        }
+        fprintf(report, "\n%12s %8s %10s %10s\n", "bytes", "n",
+                "writev", "splice");
+    }
+    target = PATTERN_TUNE_MIN_BYTES;
+    for (int s = 0; s < PATTERN_TUNE_SIZES && status == 0; s++, target *= 4) {
+        for (int shape = 0; shape < PATTERN_SHAPES && status == 0; shape++) {
+            size_t n = pattern_tune_size(shape, target);
+            unsigned long long pns[2];
+            for (int k = 0; k < 2; k++) {
+                pns[k] = pattern_tune_pipe_time(&sinks[k], &pipe, shape, n,
+                                                PATTERN_TUNE_REPS);
+                if (pns[k] == 0) {
+                    status = -1;
+                }
+            }
+            splice_wins &= pns[1] * 100 <=
+                           pns[0] * (100 - PATTERN_TUNE_MARGIN);
+            fprintf(report, "%12llu %7zu%c %8.2fms %8.2fms\n",
+                    pattern_total_bytes(shape, n), n,
+                    shape == PATTERN_TRIANGLE ? 't' : 'c', pns[0] / 1e6,
+                    pns[1] / 1e6);
+        }
+    }
+
+    if (status == 0) {
+        pf->table_max = table_max;
+        pf->pipe_sink = splice_wins ? PATTERN_SINK_SPLICE
+                                    : PATTERN_SINK_WRITEV;
+        pf->buffer_min = pattern_tune_threshold(bytes, ns[1], ns[0],
+                                                PATTERN_TUNE_SIZES);
+        pf->mmap_min = pattern_tune_threshold(bytes, ns[2], ns[0],
+                                              PATTERN_TUNE_SIZES);
+        if (pooled) {
+            pf->parallel_min = pattern_tune_threshold(bytes, ns[3], ns[0],
+                                                      PATTERN_TUNE_SIZES);
+        }
+    }
+    int err = status != 0 && one.out.error != 0 ? one.out.error : errno;
+    pattern_ctx_close(&one);
+    if (pooled) {
+        pattern_ctx_close(&pool);
+    }
+    if (piped) {
+        pattern_ctx_close(&sinks[0]);
+        pattern_ctx_close(&sinks[1]);
+        pattern_tune_pipe_close(&pipe);
+    }
+    close(fd);
+    errno = err;
+    return status;
+}
+
+#endif // PATTERN_TUNE_H
@@ -0,0 +1,132 @@
+#!/bin/sh
+#
+# check.sh
+#
+# Checks that the generated small-size tables are current, builds both
+# programs with warnings on, runs their --self-test, and compares the
+# text of every engine against the programs' own printf loops
+# (--sink stdio), one size at a time and in batches whose sizes
+# grow, so masters and ladders are rebuilt while rows are still queued.
+# Then builds the C++ headers together, and checks that the render
+# daemon refuses oversized patterns.
+#
+# Usage: scripts/check.sh [build-dir]   (default: a temporary directory)
+# Exit status is 0 when everything matches, 1 otherwise.
+#
+# Author: Dev Lunagariya
+# Date: January 2026
+# License: MIT
+
+set -u
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=${1:-$(mktemp -d)}
+mkdir -p "$out"
+cc=${CC:-gcc}
+failed=0
+
+fail() {
+    echo "FAIL: $*"
+    failed=1
+}
+
+build() {
+    $cc -O2 -Wall -Wextra -Werror -pthread -I"$root/lib" "$1" -o "$2" ||
+        fail "build $1"
+}
+
+# lib/pattern_table_data.h must be what scripts/gen_tables.c writes now
+build "$root/scripts/gen_tables.c" "$out/gen_tables"
+"$out/gen_tables" > "$out/pattern_table_data.h" &&
+    cmp -s "$out/pattern_table_data.h" "$root/lib/pattern_table_data.h" ||
+    fail "lib/pattern_table_data.h is out of date; regenerate it with scripts/gen_tables.c"
+
+build "$root/triangle/triangle.c" "$out/triangle"
+build "$root/concentric-square/concentric_square.c" "$out/concentric_square"
+[ "$failed" -eq 0 ] || exit 1
+
+# Sizes around the table limit (16), two-digit cells, and growing batches
+batches="1 2 5 16 17 100 1000 1,2,3,17,16 200,300 5,100,40,1000,3"
+
+for prog in triangle concentric_square; do
+    bin="$out/$prog"
+    "$bin" --self-test > "$out/$prog.selftest" ||
+        fail "$prog --self-test: $(grep -v ' ok$' "$out/$prog.selftest")"
+
+    for batch in $batches; do
+        sizes=$(echo "$batch" | tr , ' ')
+        # shellcheck disable=SC2086
+        "$bin" -s stdio $sizes > "$out/want" || fail "$prog -s stdio $sizes"
+
+        for engine in "" "-s writev" "-s buffer" "-j 4"; do
+            # shellcheck disable=SC2086
+            "$bin" $engine $sizes > "$out/got" &&
+                cmp -s "$out/want" "$out/got" ||
+                fail "$prog $engine $sizes"
+        done
+        # shellcheck disable=SC2086
+        "$bin" -s splice $sizes | cat > "$out/got" &&
+            cmp -s "$out/want" "$out/got" ||
+            fail "$prog -s splice $sizes (pipe)"
+        # shellcheck disable=SC2086
+        "$bin" -s mmap -o "$out/got" $sizes &&
+            cmp -s "$out/want" "$out/got" ||
+            fail "$prog -s mmap $sizes"
+        # shellcheck disable=SC2086
+        "$bin" -f rle $sizes | "$bin" --decode > "$out/got" &&
+            cmp -s "$out/want" "$out/got" ||
+            fail "$prog -f rle | --decode $sizes"
+        # The same requests, one per line on stdin
+        echo "$sizes" | tr ' ' '\n' | "$bin" > "$out/got" &&
+            cmp -s "$out/want" "$out/got" ||
+            fail "$prog stdin $sizes"
+    done
+done
+
+# C++ headers: the documented ones must build together in one
+# translation unit, and their names must not collide
+cxx=${CXX:-g++}
+cat > "$out/headers.cpp" <<'EOF'
+#include "pattern_static.hpp"
+#include "pattern_format.hpp"
+#include "pattern_ranges.hpp"
+
+int main() {
+    auto rows = pattern::views::triangle(3);
+    return pattern::triangle_view<3> == "* \n* * \n* * * \n" &&
+                   rows.size() == 3 && rows[2] == "* * * \n"
+               ? 0
+               : 1;
+}
+EOF
+$cxx -std=c++20 -O2 -Wall -Wextra -Werror -pthread -I"$root/lib" \
+    "$out/headers.cpp" -o "$out/headers" && "$out/headers" ||
+    fail "C++ headers in one translation unit"
+
+# Render daemon: a pattern over --entry-max is refused with EFBIG before
+# anything is allocated, and a small one still arrives intact
+build "$root/daemon/pattern_daemon.c" "$out/pattern_daemon"
+build "$root/daemon/pattern_client.c" "$out/pattern_client"
+sock="$out/daemon.sock"
+rm -f "$sock"
+"$out/pattern_daemon" --socket "$sock" --cache 64 --entry-max 1 2>/dev/null &
+daemon=$!
+tries=0
+while [ ! -S "$sock" ] && [ "$tries" -lt 50 ]; do
+    sleep 0.1
+    tries=$((tries + 1))
+done
+if "$out/pattern_client" -s "$sock" concentric 100000000 \
+        > /dev/null 2> "$out/err" || ! grep -q "too large" "$out/err"; then
+    fail "pattern_daemon: oversized request not refused with EFBIG"
+fi
+"$out/pattern_client" -s "$sock" concentric 100 > "$out/got" &&
+    "$out/concentric_square" -s stdio 100 | cmp -s - "$out/got" ||
+    fail "pattern_daemon: concentric 100"
+kill "$daemon"
+wait "$daemon" 2>/dev/null
+
+if [ "$failed" -eq 0 ]; then
+    echo "all checks passed"
+fi
+exit "$failed"
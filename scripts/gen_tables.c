@@ -0,0 +1,72 @@
+/**
+ * gen_tables.c
+ *
+ * Writes lib/pattern_table_data.h: the text of both patterns for
+ * n = 1..TABLE_MAX_N as C string literals, one source line per row,
+ * rendered by the library's own masters. The programs serve small sizes
+ * straight from these literals (lib/pattern_table.h), so regenerate the
+ * header whenever the pattern format changes; scripts/check.sh fails
+ * while it is out of date.
+ *
+ * Compile: gcc -O2 -pthread -Ilib scripts/gen_tables.c -o gen_tables
+ * Usage:   ./gen_tables > lib/pattern_table_data.h
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pattern_render.h"
+
+// Largest n in the tables (cells have at most two digits)
+#define TABLE_MAX_N 16
+
+int main(void) {
+    pattern_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    static char text[4096];
+    if (triangle_master_reserve(&ctx.tri, TABLE_MAX_N) != 0 ||
+        concentric_master_reserve(&ctx.con, TABLE_MAX_N) != 0 ||
+        pattern_total_bytes(PATTERN_CONCENTRIC, TABLE_MAX_N) > sizeof(text)) {
+        fprintf(stderr, "gen_tables: cannot render the tables\n");
+        return 1;
+    }
+
+    printf("/**\n"
+           " * pattern_table_data.h\n"
+           " *\n"
+           " * Generated by scripts/gen_tables.c; do not edit.\n"
+           " */\n\n"
+           "#ifndef PATTERN_TABLE_DATA_H\n"
+           "#define PATTERN_TABLE_DATA_H\n\n"
+           "// Largest n in the tables\n"
+           "#define PATTERN_TABLE_MAX_N %d\n",
+           TABLE_MAX_N);
+    for (int shape = 0; shape < PATTERN_SHAPES; shape++) {
+        printf("\nstatic const char *const pattern_table_%s"
+               "[PATTERN_TABLE_MAX_N + 1] = {\n    NULL,\n",
+               pattern_shape_names[shape]);
+        for (size_t n = 1; n <= TABLE_MAX_N; n++) {
+            pattern_render_buffer(&ctx, shape, n, text);
+            const char *row = text;
+            const char *end = text + pattern_total_bytes(shape, n);
+            while (row < end) {
+                const char *eol = memchr(row, '\n', (size_t)(end - row));
+                printf("    \"%.*s\\n\"%s\n", (int)(eol - row), row,
+                       eol + 1 == end ? "," : "");
+                row = eol + 1;
+            }
+        }
+        printf("};\n");
+    }
+    printf("\n#endif // PATTERN_TABLE_DATA_H\n");
+
+    triangle_master_free(&ctx.tri);
+    concentric_master_free(&ctx.con);
+    return ferror(stdout) ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * pattern_loadgen.c
+ *
+ * Local load generator for pattern_server.
+ *
+ * Opens one keep-alive connection per thread, sends GET requests in a
+ * closed loop (each connection waits for its response before sending the
+ * next request), cycles through the given paths, and reports throughput
+ * and latency percentiles:
+ *
+ *   ./pattern_loadgen -c 8 -d 10 /triangle/100 /concentric/500
+ *   ./pattern_loadgen -R bytes=1000-1999 /concentric/100000
+ *
+ * Compile: gcc -O2 -pthread pattern_loadgen.c -o pattern_loadgen
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOADGEN_BUFFER (64u << 10)
+
+typedef struct loadgen_config {
+    const char *host;
+    int port;
+    int connections;
+    double seconds;
+    const char *range;
+    char **paths;
+    int path_count;
+} loadgen_config;
+
+/**
+ * One connection's results
+ */
+typedef struct loadgen_client {
+    const loadgen_config *cfg;
+    int index;
+    unsigned long long *latency_ns;
+    size_t count;
+    size_t cap;
+    unsigned long long errors;
+    unsigned long long body_bytes;
+} loadgen_client;
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+static int connect_server(const loadgen_config *cfg) {
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((unsigned short)cfg->port),
+    };
+    if (inet_pton(AF_INET, cfg->host, &addr.sin_addr) != 1) {
+        return -1;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Sends one request and reads its whole response
+ *
+ * @return 0 on a 2xx response, -1 on any failure (the connection is then
+ *         reopened by the caller)
+ */
+static int exchange(loadgen_client *cl, int fd, const char *path,
+                    char *buf) {
+    char request[512];
+    int len = snprintf(request, sizeof(request),
+                       "GET %s HTTP/1.1\r\nHost: %s\r\n%s%s%s\r\n",
+                       path, cl->cfg->host,
+                       cl->cfg->range ? "Range: " : "",
+                       cl->cfg->range ? cl->cfg->range : "",
+                       cl->cfg->range ? "\r\n" : "");
+    if (send(fd, request, (size_t)len, MSG_NOSIGNAL) != len) {
+        return -1;
+    }
+
+    // Read until the end of the response head
+    size_t have = 0;
+    char *head_end = NULL;
+    while (head_end == NULL) {
+        if (have == LOADGEN_BUFFER) {
+            return -1;
+        }
+        ssize_t got = recv(fd, buf + have, LOADGEN_BUFFER - have, 0);
+        if (got <= 0) {
+            return -1;
+        }
+        have += (size_t)got;
+        head_end = memmem(buf, have, "\r\n\r\n", 4);
+    }
+
+    int status = 0;
+    sscanf(buf, "HTTP/1.%*d %d", &status);
+    unsigned long long length = 0;
+    for (char *h = strstr(buf, "\r\n"); h != NULL && h < head_end;
+         h = strstr(h + 2, "\r\n")) {
+        if (strncasecmp(h + 2, "Content-Length:", 15) == 0) {
+            length = strtoull(h + 17, NULL, 10);
+        }
+    }
+
+    // Drain the body
+    size_t head_len = (size_t)(head_end - buf) + 4;
+    unsigned long long received = have - head_len;
+    while (received < length) {
+        unsigned long long want = length - received;
+        ssize_t got = recv(fd, buf, want < LOADGEN_BUFFER ? want
+                                                          : LOADGEN_BUFFER,
+                           0);
+        if (got <= 0) {
+            return -1;
+        }
+        received += (unsigned long long)got;
+    }
+    cl->body_bytes += length;
+    return status >= 200 && status < 300 ? 0 : -1;
+}
+
+static void *client_main(void *arg) {
+    loadgen_client *cl = arg;
+    const loadgen_config *cfg = cl->cfg;
+    char *buf = malloc(LOADGEN_BUFFER);
+    unsigned long long stop = now_ns() +
+                              (unsigned long long)(cfg->seconds * 1e9);
+    int fd = -1;
+    size_t next = (size_t)cl->index;
+
+    while (buf != NULL && now_ns() < stop) {
+        if (fd < 0 && (fd = connect_server(cfg)) < 0) {
+            cl->errors++;
+            usleep(10000);
+            continue;
+        }
+
+        const char *path = cfg->paths[next++ % (size_t)cfg->path_count];
+        unsigned long long start = now_ns();
+        if (exchange(cl, fd, path, buf) != 0) {
+            cl->errors++;
+            close(fd);
+            fd = -1;
+            continue;
+        }
+
+        if (cl->count == cl->cap) {
+            size_t cap = cl->cap ? cl->cap * 2 : 4096;
+            unsigned long long *grown =
+                realloc(cl->latency_ns, cap * sizeof(*grown));
+            if (grown == NULL) {
+                break;
+            }
+            cl->latency_ns = grown;
+            cl->cap = cap;
+        }
+        cl->latency_ns[cl->count++] = now_ns() - start;
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(buf);
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long *)a;
+    unsigned long long y = *(const unsigned long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of a sorted sample, in microseconds
+ */
+static double percentile_us(const unsigned long long *sorted, size_t count,
+                            double pct) {
+    size_t rank = (size_t)(pct / 100.0 * (double)count);
+    if (rank >= count) {
+        rank = count - 1;
+    }
+    return (double)sorted[rank] / 1000.0;
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_loadgen [options] path...\n"
+        "\n"
+        "  -H, --host ADDR        server address (default: 127.0.0.1)\n"
+        "  -p, --port PORT        server port (default: 8080)\n"
+        "  -c, --connections N    concurrent connections (default: 4)\n"
+        "  -d, --duration SEC     test length in seconds (default: 5)\n"
+        "  -R, --range SPEC       send \"Range: SPEC\" with every request\n"
+        "  -h, --help             show this help\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"host",        required_argument, NULL, 'H'},
+        {"port",        required_argument, NULL, 'p'},
+        {"connections", required_argument, NULL, 'c'},
+        {"duration",    required_argument, NULL, 'd'},
+        {"range",       required_argument, NULL, 'R'},
+        {"help",        no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    loadgen_config cfg = {
+        .host = "127.0.0.1",
+        .port = 8080,
+        .connections = 4,
+        .seconds = 5.0,
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "H:p:c:d:R:h", longopts,
+                              NULL)) != -1) {
+        switch (opt) {
+        case 'H':
+            cfg.host = optarg;
+            break;
+        case 'p':
+            cfg.port = atoi(optarg);
+            break;
+        case 'c':
+            cfg.connections = atoi(optarg);
+            break;
+        case 'd':
+            cfg.seconds = atof(optarg);
+            break;
+        case 'R':
+            cfg.range = optarg;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (optind == argc || cfg.connections < 1 || cfg.seconds <= 0) {
+        usage(stderr);
+        return 1;
+    }
+    cfg.paths = argv + optind;
+    cfg.path_count = argc - optind;
+
+    loadgen_client *clients = calloc((size_t)cfg.connections,
+                                     sizeof(*clients));
+    pthread_t *threads = calloc((size_t)cfg.connections, sizeof(*threads));
+    if (clients == NULL || threads == NULL) {
+        fprintf(stderr, "pattern_loadgen: out of memory\n");
+        return 1;
+    }
+
+    unsigned long long start = now_ns();
+    for (int c = 0; c < cfg.connections; c++) {
+        clients[c].cfg = &cfg;
+        clients[c].index = c;
+        pthread_create(&threads[c], NULL, client_main, &clients[c]);
+    }
+
+    // Merge every connection's samples
+    size_t total = 0;
+    unsigned long long errors = 0;
+    unsigned long long bytes = 0;
+    for (int c = 0; c < cfg.connections; c++) {
+        pthread_join(threads[c], NULL);
+        total += clients[c].count;
+        errors += clients[c].errors;
+        bytes += clients[c].body_bytes;
+    }
+    double elapsed = (double)(now_ns() - start) / 1e9;
+
+    unsigned long long *all = malloc((total ? total : 1) * sizeof(*all));
+    size_t at = 0;
+    for (int c = 0; c < cfg.connections; c++) {
+        memcpy(all + at, clients[c].latency_ns,
+               clients[c].count * sizeof(*all));
+        at += clients[c].count;
+        free(clients[c].latency_ns);
+    }
+    qsort(all, total, sizeof(*all), compare_u64);
+
+    printf("requests:    %zu (%llu errors) in %.2f s\n", total, errors,
+           elapsed);
+    printf("throughput:  %.0f requests/s, %.1f MB/s\n",
+           (double)total / elapsed, (double)bytes / elapsed / 1e6);
+    if (total > 0) {
+        printf("latency us:  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  "
+               "max %.1f\n",
+               percentile_us(all, total, 50), percentile_us(all, total, 90),
+               percentile_us(all, total, 99),
+               percentile_us(all, total, 99.9),
+               (double)all[total - 1] / 1000.0);
+    }
+
+    free(all);
+    free(clients);
+    free(threads);
+    return errors > 0 && total == 0 ? 1 : 0;
+}
@@ -0,0 +1,849 @@
+/**
+ * pattern_server.c
+ *
+ * Serves both patterns over HTTP on a local port, so that many clients
+ * share one set of renders instead of each running the programs:
+ *
+ *   GET /triangle/{n}
+ *   GET /concentric/{n}
+ *
+ * Every response carries an exact Content-Length taken from the
+ * closed-form sizes in lib/, before a single byte is rendered. Single
+ * "Range: bytes=..." requests are answered with 206 Partial Content by
+ * rendering only the requested bytes (pattern_render_range).
+ *
+ * Design:
+ * - One epoll event loop per thread. Each thread owns a listening socket
+ *   bound with SO_REUSEPORT, so the kernel spreads connections across
+ *   threads and no lock is taken on the accept path.
+ * - Triangles up to --entry-max bytes are rendered once into a memfd and
+ *   kept in a shared LRU cache bounded by --cache. Bodies are sent from
+ *   there with sendfile(2), or with a single writev(2) together with the
+ *   headers when the body is small.
+ * - Concentric squares are cached as their two number ladders
+ *   (lib/pattern_compact.h): kilobytes where the text takes gigabytes,
+ *   so --entry-max limits that footprint instead. Bodies are expanded
+ *   from it in 256 KiB chunks.
+ * - Larger patterns are never materialized: the requested range is
+ *   rendered in 256 KiB chunks straight into a per-connection buffer,
+ *   from the worker's own master or ladders. Those grow to the largest
+ *   n the worker has streamed and are reused by later requests; the
+ *   request that grows them pays O(n) once, on its worker's loop.
+ *
+ * Compile: gcc -O2 -pthread pattern_server.c -o pattern_server
+ * Run: ./pattern_server --port 8080 --threads 4
+ *
+ * Author: Dev Lunagariya
+ * Date: January 2026
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <getopt.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+
+#include "../lib/pattern_compact.h"
+
+// Request head limit; longer heads are rejected
+#define SERVER_HEAD_MAX 8192
+
+// Streaming chunk for patterns that are not cached
+#define SERVER_CHUNK (256u << 10)
+
+// Bodies up to this size go out in one writev together with the headers
+#define SERVER_WRITEV_MAX (64u << 10)
+
+// Bytes handed to one sendfile call
+#define SERVER_SENDFILE_MAX (4u << 20)
+
+#define SERVER_MAX_EVENTS 256
+
+/**
+ * A cached pattern: rendered text in a memfd, or a compact square
+ *
+ * refs counts the cache's own reference plus every response in flight,
+ * so an entry evicted while still being sent stays alive until the last
+ * response releases it.
+ */
+typedef struct cache_entry {
+    int shape;
+    size_t n;
+    int fd;                     // -1 for compact entries
+    const char *data;           // read-only mapping of the memfd
+    concentric_compact *compact;    // or the square's ladders
+    size_t size;                // bytes held: text, or compact footprint
+    int refs;
+    unsigned long long used;    // LRU clock value of the last hit
+    struct cache_entry *next;
+} cache_entry;
+
+typedef struct server_cache {
+    pthread_mutex_t lock;
+    cache_entry *head;
+    size_t bytes;
+    size_t budget;
+    size_t entry_max;           // larger patterns are streamed instead
+    unsigned long long clock;
+} server_cache;
+
+/**
+ * Per-connection state: input buffer, then one response at a time
+ */
+typedef struct conn {
+    int fd;
+    char in[SERVER_HEAD_MAX];
+    size_t in_len;
+    int keep_alive;
+    int busy;                   // a response is being sent
+
+    char head[512];
+    size_t head_len;
+    size_t head_sent;
+
+    cache_entry *entry;         // cached body source, or NULL to stream
+    int shape;
+    size_t n;
+    unsigned long long off;     // next body byte to send
+    unsigned long long end;     // one past the last body byte
+
+    char *chunk;                // streaming buffer (SERVER_CHUNK bytes)
+    size_t chunk_len;
+    size_t chunk_sent;
+} conn;
+
+typedef struct server_config {
+    const char *bind;
+    int port;
+    int threads;
+} server_config;
+
+typedef struct worker {
+    int index;
+    int listen_fd;
+    int epoll_fd;
+    server_cache *cache;
+    pattern_ctx ctx;            // masters for streaming, no writer needed
+} worker;
+
+/* ------------------------------------------------------------------ */
+/* Cache                                                               */
+/* ------------------------------------------------------------------ */
+
+static void cache_entry_destroy(cache_entry *e) {
+    if (e->compact != NULL) {
+        concentric_compact_free(e->compact);
+        free(e->compact);
+    } else {
+        munmap((void *)e->data, e->size);
+        close(e->fd);
+    }
+    free(e);
+}
+
+static void cache_release(server_cache *cache, cache_entry *e) {
+    pthread_mutex_lock(&cache->lock);
+    int last = --e->refs == 0;
+    pthread_mutex_unlock(&cache->lock);
+    if (last) {
+        cache_entry_destroy(e);
+    }
+}
+
+/**
+ * Looks up (shape, n); a hit returns a new reference
+ */
+static cache_entry *cache_get(server_cache *cache, int shape, size_t n) {
+    pthread_mutex_lock(&cache->lock);
+    cache_entry *e = cache->head;
+    while (e != NULL && (e->shape != shape || e->n != n)) {
+        e = e->next;
+    }
+    if (e != NULL) {
+        e->refs++;
+        e->used = ++cache->clock;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return e;
+}
+
+/**
+ * Inserts a freshly rendered entry (which arrives with one reference,
+ * the caller's) and evicts least recently used entries over budget
+ *
+ * If another thread cached the same pattern meanwhile, the new entry is
+ * dropped and the existing one returned instead.
+ */
+static cache_entry *cache_put(server_cache *cache, cache_entry *fresh) {
+    cache_entry *evicted = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    for (cache_entry *e = cache->head; e != NULL; e = e->next) {
+        if (e->shape == fresh->shape && e->n == fresh->n) {
+            e->refs++;
+            e->used = ++cache->clock;
+            pthread_mutex_unlock(&cache->lock);
+            cache_entry_destroy(fresh);
+            return e;
+        }
+    }
+
+    fresh->refs++;              // the cache's own reference
+    fresh->used = ++cache->clock;
+    fresh->next = cache->head;
+    cache->head = fresh;
+    cache->bytes += fresh->size;
+
+    while (cache->bytes > cache->budget) {
+        cache_entry **victim = NULL;
+        for (cache_entry **link = &cache->head; *link != NULL;
+             link = &(*link)->next) {
+            if (*link != fresh &&
+                (victim == NULL || (*link)->used < (*victim)->used)) {
+                victim = link;
+            }
+        }
+        if (victim == NULL) {
+            break;
+        }
+        cache_entry *e = *victim;
+        *victim = e->next;
+        cache->bytes -= e->size;
+        if (--e->refs == 0) {
+            e->next = evicted;
+            evicted = e;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    while (evicted != NULL) {
+        cache_entry *next = evicted->next;
+        cache_entry_destroy(evicted);
+        evicted = next;
+    }
+    return fresh;
+}
+
+/**
+ * Renders a whole pattern into a new memfd-backed entry
+ *
+ * The memfd is what lets the body go out with sendfile(2) later.
+ *
+ * @return Entry holding one reference, or NULL on failure
+ */
+static cache_entry *render_entry(pattern_ctx *ctx, int shape, size_t n) {
+    size_t size = (size_t)pattern_total_bytes(shape, n);
+    if (pattern_ctx_reserve(ctx, shape, n) != 0) {
+        return NULL;
+    }
+
+    int fd = memfd_create("pattern", MFD_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    char *data = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    cache_entry *e = malloc(sizeof(*e));
+    if (data == MAP_FAILED || e == NULL) {
+        if (data != MAP_FAILED) {
+            munmap(data, size);
+        }
+        free(e);
+        close(fd);
+        return NULL;
+    }
+
+    pattern_render_buffer(ctx, shape, n, data);
+    mprotect(data, size, PROT_READ);
+
+    memset(e, 0, sizeof(*e));
+    e->shape = shape;
+    e->n = n;
+    e->fd = fd;
+    e->data = data;
+    e->size = size;
+    e->refs = 1;
+    return e;
+}
+
+/**
+ * Builds the compact form of a concentric square into a new entry
+ *
+ * @return Entry holding one reference, or NULL on failure
+ */
+static cache_entry *compact_entry(size_t n) {
+    cache_entry *e = calloc(1, sizeof(*e));
+    concentric_compact *cc = malloc(sizeof(*cc));
+    if (e == NULL || cc == NULL || concentric_compact_init(cc, n) != 0) {
+        free(cc);
+        free(e);
+        return NULL;
+    }
+    e->shape = PATTERN_CONCENTRIC;
+    e->n = n;
+    e->fd = -1;
+    e->compact = cc;
+    e->size = concentric_compact_footprint(cc);
+    e->refs = 1;
+    return e;
+}
+
+/* ------------------------------------------------------------------ */
+/* HTTP                                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Parses "bytes=a-b", "bytes=a-" or "bytes=-suffix" against `size`
+ *
+ * @return 1 for a satisfiable range, 0 to ignore the header (malformed
+ *         or multiple ranges: RFC 9110 allows answering those with 200),
+ *         -1 if the range cannot be satisfied (416)
+ */
+static int parse_range(const char *value, unsigned long long size,
+                       unsigned long long *first, unsigned long long *last) {
+    if (strncasecmp(value, "bytes=", 6) != 0 || strchr(value, ',') != NULL) {
+        return 0;
+    }
+    const char *p = value + 6;
+    char *end;
+
+    if (*p == '-') {
+        if (!isdigit((unsigned char)p[1])) {
+            return 0;
+        }
+        unsigned long long suffix = strtoull(p + 1, &end, 10);
+        if (suffix == 0) {
+            return -1;
+        }
+        *first = suffix >= size ? 0 : size - suffix;
+        *last = size - 1;
+        return size > 0 ? 1 : -1;
+    }
+
+    if (!isdigit((unsigned char)*p)) {
+        return 0;
+    }
+    *first = strtoull(p, &end, 10);
+    if (*end != '-') {
+        return 0;
+    }
+    p = end + 1;
+    if (isdigit((unsigned char)*p)) {
+        *last = strtoull(p, &end, 10);
+        if (*last < *first) {
+            return 0;
+        }
+    } else {
+        *last = size - 1;
+    }
+    if (*first >= size) {
+        return -1;
+    }
+    if (*last >= size) {
+        *last = size - 1;
+    }
+    return 1;
+}
+
+/**
+ * Queues a response without a pattern body (errors)
+ */
+static void respond_plain(conn *c, int status, const char *reason,
+                          const char *extra) {
+    char body[64];
+    int body_len = snprintf(body, sizeof(body), "%d %s\n", status, reason);
+    memcpy(c->chunk, body, (size_t)body_len);
+
+    c->head_len = (size_t)snprintf(c->head, sizeof(c->head),
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: text/plain\r\n"
+        "Content-Length: %d\r\n"
+        "%s"
+        "Connection: %s\r\n\r\n",
+        status, reason, body_len, extra ? extra : "",
+        c->keep_alive ? "keep-alive" : "close");
+    c->head_sent = 0;
+    c->entry = NULL;
+    c->chunk_len = (size_t)body_len;
+    c->chunk_sent = 0;
+    c->off = 0;
+    c->end = (unsigned long long)body_len;
+    c->busy = 1;
+}
+
+/**
+ * Turns one complete request head into a response
+ *
+ * @param head Request head, NUL-terminated, without the blank line
+ */
+static void handle_request(worker *w, conn *c, char *head) {
+    char *line_end = strstr(head, "\r\n");
+    if (line_end != NULL) {
+        *line_end = '\0';
+    }
+
+    char method[8], path[256], version[16];
+    if (sscanf(head, "%7s %255s %15s", method, path, version) != 3) {
+        c->keep_alive = 0;
+        respond_plain(c, 400, "Bad Request", NULL);
+        return;
+    }
+    c->keep_alive = strcmp(version, "HTTP/1.1") == 0;
+
+    // Headers we care about: Connection and Range
+    const char *range = NULL;
+    for (char *h = line_end ? line_end + 2 : NULL; h != NULL && *h != '\0';) {
+        char *next = strstr(h, "\r\n");
+        if (next != NULL) {
+            *next = '\0';
+        }
+        char *colon = strchr(h, ':');
+        if (colon != NULL) {
+            *colon = '\0';
+            char *value = colon + 1 + strspn(colon + 1, " \t");
+            if (strcasecmp(h, "Connection") == 0) {
+                if (strcasecmp(value, "close") == 0) {
+                    c->keep_alive = 0;
+                } else if (strcasecmp(value, "keep-alive") == 0) {
+                    c->keep_alive = 1;
+                }
+            } else if (strcasecmp(h, "Range") == 0) {
+                range = value;
+            }
+        }
+        h = next ? next + 2 : NULL;
+    }
+
+    int is_head = strcmp(method, "HEAD") == 0;
+    if (!is_head && strcmp(method, "GET") != 0) {
+        respond_plain(c, 405, "Method Not Allowed", "Allow: GET, HEAD\r\n");
+        return;
+    }
+
+    // /triangle/{n} or /concentric/{n}
+    char *slash = path[0] == '/' ? strchr(path + 1, '/') : NULL;
+    size_t n;
+    int shape = -1;
+    if (slash != NULL) {
+        *slash = '\0';
+        shape = pattern_shape_parse(path + 1);
+    }
+    if (shape < 0 || pattern_parse_size(slash + 1, &n) != 0) {
+        respond_plain(c, 404, "Not Found", NULL);
+        return;
+    }
+
+    unsigned long long size = pattern_total_bytes(shape, n);
+    unsigned long long first = 0;
+    unsigned long long last = size - 1;
+    int partial = range ? parse_range(range, size, &first, &last) : 0;
+    if (partial < 0) {
+        char extra[64];
+        snprintf(extra, sizeof(extra), "Content-Range: bytes */%llu\r\n",
+                 size);
+        respond_plain(c, 416, "Range Not Satisfiable", extra);
+        return;
+    }
+
+    char content_range[96] = "";
+    if (partial) {
+        snprintf(content_range, sizeof(content_range),
+                 "Content-Range: bytes %llu-%llu/%llu\r\n",
+                 first, last, size);
+    }
+    c->head_len = (size_t)snprintf(c->head, sizeof(c->head),
+        "HTTP/1.1 %s\r\n"
+        "Content-Type: text/plain; charset=utf-8\r\n"
+        "Content-Length: %llu\r\n"
+        "Accept-Ranges: bytes\r\n"
+        "%s"
+        "Connection: %s\r\n\r\n",
+        partial ? "206 Partial Content" : "200 OK",
+        last - first + 1, content_range,
+        c->keep_alive ? "keep-alive" : "close");
+    c->head_sent = 0;
+    c->shape = shape;
+    c->n = n;
+    c->off = first;
+    c->end = is_head ? first : last + 1;
+    c->chunk_len = 0;
+    c->chunk_sent = 0;
+    c->entry = NULL;
+    c->busy = 1;
+
+    if (c->off == c->end) {
+        return;
+    }
+
+    // Cacheable patterns are built once and shared; squares are cached as
+    // their ladders, which are far smaller than text. The rest stream from
+    // the worker's own master or ladders, which only grow, so one large n
+    // is paid for once per worker and not once per request.
+    int compact = shape == PATTERN_CONCENTRIC;
+    size_t held = compact ? (size_t)concentric_ladder_bytes(n) * 2 : size;
+    if (held <= w->cache->entry_max) {
+        c->entry = cache_get(w->cache, shape, n);
+        if (c->entry == NULL) {
+            cache_entry *fresh = compact ? compact_entry(n)
+                                         : render_entry(&w->ctx, shape, n);
+            if (fresh != NULL) {
+                c->entry = cache_put(w->cache, fresh);
+            }
+        }
+    }
+    if (c->entry == NULL && pattern_ctx_reserve(&w->ctx, shape, n) != 0) {
+        c->keep_alive = 0;
+        respond_plain(c, 500, "Internal Server Error", NULL);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Connections                                                         */
+/* ------------------------------------------------------------------ */
+
+static void conn_close(worker *w, conn *c) {
+    if (c->entry != NULL) {
+        cache_release(w->cache, c->entry);
+    }
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    free(c->chunk);
+    free(c);
+}
+
+/**
+ * Parses the next buffered request, if a complete head is available
+ *
+ * @return 1 if a response was started, 0 if more input is needed,
+ *         -1 if the connection should be closed
+ */
+static int conn_next_request(worker *w, conn *c) {
+    char *end = memmem(c->in, c->in_len, "\r\n\r\n", 4);
+    if (end == NULL) {
+        return c->in_len == sizeof(c->in) ? -1 : 0;
+    }
+    *end = '\0';
+    size_t used = (size_t)(end - c->in) + 4;
+    handle_request(w, c, c->in);
+    memmove(c->in, c->in + used, c->in_len - used);
+    c->in_len -= used;
+    return 1;
+}
+
+/**
+ * Pushes as much of the current response as the socket accepts
+ *
+ * @return 1 if the socket is full (wait for EPOLLOUT), 0 when the
+ *         response is complete, -1 on error
+ */
+static int conn_send(worker *w, conn *c) {
+    for (;;) {
+        size_t head_left = c->head_len - c->head_sent;
+        unsigned long long body_left = c->end - c->off;
+        if (head_left == 0 && body_left == 0) {
+            return 0;
+        }
+
+        // Streamed and compact bodies: render the next chunk of the range
+        int chunked = c->entry == NULL || c->entry->compact != NULL;
+        if (chunked && body_left > 0 && c->chunk_sent == c->chunk_len) {
+            size_t len = body_left < SERVER_CHUNK ? (size_t)body_left
+                                                  : SERVER_CHUNK;
+            if (c->entry != NULL) {
+                concentric_compact_range(c->entry->compact, c->off, len,
+                                         c->chunk);
+            } else {
+                pattern_render_range(&w->ctx, c->shape, c->n, c->off, len,
+                                     c->chunk);
+            }
+            c->chunk_len = len;
+            c->chunk_sent = 0;
+        }
+
+        ssize_t done;
+        if (!chunked && head_left == 0 &&
+            body_left > SERVER_WRITEV_MAX) {
+            off_t off = (off_t)c->off;
+            size_t len = body_left < SERVER_SENDFILE_MAX
+                             ? (size_t)body_left : SERVER_SENDFILE_MAX;
+            done = sendfile(c->fd, c->entry->fd, &off, len);
+        } else {
+            struct iovec iov[2];
+            int cnt = 0;
+            if (head_left > 0) {
+                iov[cnt].iov_base = c->head + c->head_sent;
+                iov[cnt++].iov_len = head_left;
+            }
+            if (body_left > 0) {
+                if (!chunked) {
+                    iov[cnt].iov_base = (char *)c->entry->data + c->off;
+                    iov[cnt++].iov_len = body_left < SERVER_WRITEV_MAX
+                                             ? (size_t)body_left
+                                             : SERVER_WRITEV_MAX;
+                } else {
+                    iov[cnt].iov_base = c->chunk + c->chunk_sent;
+                    iov[cnt++].iov_len = c->chunk_len - c->chunk_sent;
+                }
+            }
+            done = writev(c->fd, iov, cnt);
+        }
+
+        if (done < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN ? 1 : -1;
+        }
+
+        size_t sent = (size_t)done;
+        size_t from_head = sent < head_left ? sent : head_left;
+        c->head_sent += from_head;
+        sent -= from_head;
+        c->off += sent;
+        if (chunked) {
+            c->chunk_sent += sent;
+        }
+    }
+}
+
+/**
+ * Drives one connection as far as it can go without blocking
+ *
+ * @return 0 to keep the connection, -1 to close it
+ */
+static int conn_drive(worker *w, conn *c) {
+    for (;;) {
+        if (c->busy) {
+            int status = conn_send(w, c);
+            if (status < 0) {
+                return -1;
+            }
+            if (status > 0) {
+                struct epoll_event ev = {.events = EPOLLOUT, .data.ptr = c};
+                epoll_ctl(w->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+                return 0;
+            }
+            // Response complete
+            c->busy = 0;
+            if (c->entry != NULL) {
+                cache_release(w->cache, c->entry);
+                c->entry = NULL;
+            }
+            if (!c->keep_alive) {
+                return -1;
+            }
+            struct epoll_event ev = {.events = EPOLLIN, .data.ptr = c};
+            epoll_ctl(w->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+        }
+
+        // Pipelined requests may already be buffered
+        int next = conn_next_request(w, c);
+        if (next < 0) {
+            return -1;
+        }
+        if (next > 0) {
+            continue;
+        }
+
+        ssize_t got = recv(c->fd, c->in + c->in_len,
+                           sizeof(c->in) - c->in_len, 0);
+        if (got == 0) {
+            return -1;
+        }
+        if (got < 0) {
+            return errno == EAGAIN || errno == EINTR ? 0 : -1;
+        }
+        c->in_len += (size_t)got;
+    }
+}
+
+static void accept_all(worker *w) {
+    for (;;) {
+        int fd = accept4(w->listen_fd, NULL, NULL,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        conn *c = calloc(1, sizeof(*c));
+        char *chunk = malloc(SERVER_CHUNK);
+        if (c == NULL || chunk == NULL) {
+            free(c);
+            free(chunk);
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->chunk = chunk;
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = c};
+        if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            free(chunk);
+            free(c);
+            close(fd);
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    worker *w = arg;
+    struct epoll_event events[SERVER_MAX_EVENTS];
+
+    for (;;) {
+        int count = epoll_wait(w->epoll_fd, events, SERVER_MAX_EVENTS, -1);
+        for (int e = 0; e < count; e++) {
+            conn *c = events[e].data.ptr;
+            if (c == NULL) {
+                accept_all(w);
+            } else if ((events[e].events & (EPOLLERR | EPOLLHUP)) &&
+                       !(events[e].events & EPOLLIN)) {
+                conn_close(w, c);
+            } else if (conn_drive(w, c) != 0) {
+                conn_close(w, c);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Opens one SO_REUSEPORT listener per worker
+ *
+ * @return Listening socket, or -1 with a message on stderr
+ */
+static int open_listener(const server_config *cfg) {
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((unsigned short)cfg->port),
+    };
+    if (inet_pton(AF_INET, cfg->bind, &addr.sin_addr) != 1) {
+        fprintf(stderr, "pattern_server: bad address '%s'\n", cfg->bind);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    if (fd < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0 ||
+        bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, 1024) != 0) {
+        fprintf(stderr, "pattern_server: %s:%d: %s\n", cfg->bind, cfg->port,
+                strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static void usage(FILE *to) {
+    fprintf(to,
+        "usage: pattern_server [options]\n"
+        "\n"
+        "  -b, --bind ADDR       address to listen on (default: 127.0.0.1)\n"
+        "  -p, --port PORT       port (default: 8080)\n"
+        "  -t, --threads N       event loop threads (default: 1)\n"
+        "  -c, --cache MB        render cache budget (default: 256)\n"
+        "  -e, --entry-max MB    largest cache entry (default: 64); squares\n"
+        "                        are cached as their ladders, about\n"
+        "                        2(digits+1) bytes per n\n"
+        "  -h, --help            show this help\n");
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        {"bind",      required_argument, NULL, 'b'},
+        {"port",      required_argument, NULL, 'p'},
+        {"threads",   required_argument, NULL, 't'},
+        {"cache",     required_argument, NULL, 'c'},
+        {"entry-max", required_argument, NULL, 'e'},
+        {"help",      no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    server_config cfg = {.bind = "127.0.0.1", .port = 8080, .threads = 1};
+    server_cache cache = {
+        .budget = 256u << 20,
+        .entry_max = 64u << 20,
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "b:p:t:c:e:h", longopts,
+                              NULL)) != -1) {
+        switch (opt) {
+        case 'b':
+            cfg.bind = optarg;
+            break;
+        case 'p':
+            cfg.port = atoi(optarg);
+            break;
+        case 't':
+            cfg.threads = atoi(optarg);
+            break;
+        case 'c':
+            cache.budget = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 'e':
+            cache.entry_max = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 1;
+        }
+    }
+    if (cfg.threads < 1 || cfg.threads > PATTERN_MAX_THREADS ||
+        cfg.port <= 0 || cfg.port > 65535) {
+        usage(stderr);
+        return 1;
+    }
+    if (cache.entry_max > cache.budget) {
+        cache.entry_max = cache.budget;
+    }
+
+    pattern_ignore_sigpipe();
+    pthread_mutex_init(&cache.lock, NULL);
+
+    worker *workers = calloc((size_t)cfg.threads, sizeof(*workers));
+    pthread_t *threads = calloc((size_t)cfg.threads, sizeof(*threads));
+    if (workers == NULL || threads == NULL) {
+        fprintf(stderr, "pattern_server: out of memory\n");
+        return 1;
+    }
+
+    for (int t = 0; t < cfg.threads; t++) {
+        worker *w = &workers[t];
+        w->index = t;
+        w->cache = &cache;
+        w->listen_fd = open_listener(&cfg);
+        w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (w->listen_fd < 0 || w->epoll_fd < 0) {
+            return 1;
+        }
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+        epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->listen_fd, &ev);
+    }
+
+    fprintf(stderr, "pattern_server: listening on %s:%d with %d thread%s\n",
+            cfg.bind, cfg.port, cfg.threads, cfg.threads == 1 ? "" : "s");
+
+    for (int t = 1; t < cfg.threads; t++) {
+        pthread_create(&threads[t], NULL, worker_main, &workers[t]);
+    }
+    worker_main(&workers[0]);
+    return 0;
+}
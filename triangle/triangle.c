@@ -8,16 +8,28 @@
  * numbers to determine when to insert line breaks, effectively converting
  * a 2D pattern into a 1D iteration.
  * 
- * Compile: gcc triangle.c -o triangle
- * Run: ./triangle
+ * The program itself is a batch tool: it renders one triangle per size
+ * given as an argument or per line of stdin, with no prompt or banner.
+ * Apart from --sink stdio, which uses print_triangle() below, rows are
+ * emitted as slices of one shared master row (lib/pattern_triangle.h).
+ * If the consumer goes away early (./triangle 100000 | head), output
+ * stops within one chunk and the program exits with status 3.
+ * 
+ * Compile: gcc -O2 -pthread triangle.c -o triangle
+ * Run: ./triangle 5        or        seq 1 10 | ./triangle
  * 
  * Author: Dev Lunagariya
  * Date: January 2026
  * License: MIT
  */
 
+#define _GNU_SOURCE
+
+#include <errno.h>
 #include <stdio.h>
 
+#include "../lib/pattern_cli.h"
+
 /**
  * Prints a right triangle pattern using a single loop
  * 
@@ -40,26 +52,29 @@
  * Row 4: stars 7-10      (T(4) = 10)
  * 
  * @param n Height of the triangle (number of rows)
+ * @return 0 on success, -1 if stdout failed (e.g. the reader of a pipe
+ *         went away); the loop stops at the next row boundary
  * 
  * Time Complexity: O(n²) - prints n(n+1)/2 stars
  * Space Complexity: O(1) - uses constant extra space
  */
-void print_triangle(int n) {
+int print_triangle(int n) {
     // Validate input
     if (n <= 0) {
         printf("Error: n must be a positive integer\n");
-        return;
+        return 0;
     }
     
     // Calculate total number of stars needed using triangular number formula
     // For n=5: total = 5*6/2 = 15 stars
-    int total = n * (n + 1) / 2;
+    // In long long: n(n+1) overflows an int from n = 46341 on
+    long long total = (long long)n * (n + 1) / 2;
     
     // Track which row we're currently on (starts at 1 for the first row)
-    int row = 1;
+    long long row = 1;
     
     // Single loop iterates through all stars from 1 to total
-    for (int i = 1; i <= total; i++) {
+    for (long long i = 1; i <= total; i++) {
         // Print a star with trailing space
         printf("* ");
         
@@ -69,42 +84,34 @@ void print_triangle(int n) {
         if (i == row * (row + 1) / 2) {
             printf("\n");  // Move to next line
             row++;         // Increment row counter for next iteration
+            
+            // A failed flush of the stdio buffer means nobody is reading:
+            // stop instead of formatting the rest of the triangle
+            if (ferror(stdout)) {
+                return -1;
+            }
         }
     }
+    return 0;
 }
 
 /**
- * Main function - demonstrates the triangle printing
+ * Main function - batch command line
+ * 
+ * Sizes come from the arguments, or one per line from stdin; see
+ * lib/pattern_cli.h (or ./triangle --help) for the options. Requests are
+ * served from one render context, so the master row is formatted once
+ * for the tallest triangle in the batch.
  */
-int main() {
-    int size;
-    
-    printf("Right Triangle Pattern - Single Loop Implementation\n");
-    printf("===================================================\n\n");
-    
-    // Get input from user
-    printf("Enter the height of the triangle: ");
-    if (scanf("%d", &size) != 1) {
-        printf("Invalid input. Please enter a positive integer.\n");
-        return 1;
-    }
-    
-    printf("\n");
-    
-    // Print the triangle
-    print_triangle(size);
-    
-    printf("\n");
+int main(int argc, char **argv) {
+    pattern_cli cli = {
+        .program = "triangle",
+        .shape = PATTERN_TRIANGLE,
+        .threads = 1,
+    };
     
-    // Show some example outputs
-    printf("\nExamples of other sizes:\n");
-    printf("------------------------\n\n");
+    // The printf implementation above backs --sink stdio
+    cli.reference[PATTERN_TRIANGLE] = print_triangle;
     
-    printf("n = 3:\n");
-    print_triangle(3);
-    
-    printf("\nn = 6:\n");
-    print_triangle(6);
-    
-    return 0;
+    return pattern_cli_main(&cli, argc, argv);
 }